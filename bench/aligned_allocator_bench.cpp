@@ -0,0 +1,145 @@
+#include "bench.hpp"
+#include "aligned_allocator.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using stl_container_impl::AlignedVector;
+using stl_container_impl::CacheLinePadded;
+using stl_container_impl::Vector;
+
+namespace
+{
+    constexpr std::size_t kernel_elements = 4096; // 16 KiB per array, L1-resident
+    constexpr std::size_t kernel_passes = 100000;
+
+    constexpr std::size_t appends_per_thread = 20000000;
+    constexpr std::size_t append_capacity = 1024; // 4 KiB per thread, reused
+
+    // y += a * x over count elements starting at arbitrary addresses, with a scalar tail.
+    void axpy_unaligned(float a, const float* x, float* y, std::size_t count)
+    {
+        for (std::size_t i = 0; i != count; ++i)
+            y[i] += a * x[i];
+    }
+
+    // Same kernel over AlignedAllocator storage: aligned loads and stores, and the loop runs to
+    // the padded count in whole 64-byte blocks, so there is no tail to handle.
+    void axpy_aligned(float a, const float* x, float* y, std::size_t paddedCount)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        x = static_cast<const float*>(__builtin_assume_aligned(x, 64));
+        y = static_cast<float*>(__builtin_assume_aligned(y, 64));
+#endif
+        for (std::size_t block = 0; block != paddedCount; block += 16)
+        {
+            for (std::size_t i = block; i != block + 16; ++i)
+                y[i] += a * x[i];
+        }
+    }
+
+    // Every thread appends appends_per_thread ints to its own vector in vectors[thread]. The
+    // vector is cleared whenever it reaches append_capacity, so it never reallocates and memory
+    // stays bounded: the loop is the header update of each push_back and nothing else.
+    template <typename PerThread, typename Get>
+    double appends_per_second(unsigned threadCount, Get&& get)
+    {
+        Vector<PerThread> vectors;
+        vectors.resize(threadCount);
+
+        std::atomic<bool> start{ false };
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t != threadCount; ++t)
+        {
+            threads.emplace_back([&, t] {
+                auto& vector = get(vectors[t]);
+                vector.reserve(append_capacity);
+                while (!start.load())
+                    std::this_thread::yield();
+
+                for (std::size_t i = 0; i != appends_per_thread; ++i)
+                {
+                    if (vector.size() == append_capacity)
+                        vector.clear();
+                    vector.push_back(static_cast<int>(i));
+                }
+            });
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        start.store(true);
+        for (auto& thread : threads)
+            thread.join();
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        return threadCount * appends_per_thread / elapsed.count();
+    }
+
+} // namespace
+
+// Unaligned: a std::allocator buffer offset by one float, so every vector load is misaligned.
+// Aligned: AlignedVector, full-width iterations up to padded_count() without a scalar tail.
+STL_CONTAINER_IMPL_BENCH(aligned_kernels)
+{
+    for (const auto count : { kernel_elements - 3, kernel_elements })
+    {
+        const auto label = std::to_string(count) + " floats, y += a * x";
+
+        Vector<float> unalignedX;
+        Vector<float> unalignedY;
+        unalignedX.resize(count + 1);
+        unalignedY.resize(count + 1);
+        std::fill(unalignedX.begin(), unalignedX.end(), 1.0f);
+
+        const auto unalignedSeconds = bench::best_of(5, [&] {
+            for (std::size_t pass = 0; pass != kernel_passes; ++pass)
+            {
+                axpy_unaligned(1e-6f, unalignedX.data() + 1, unalignedY.data() + 1, count);
+                bench::do_not_optimize(unalignedY.data()[1]);
+            }
+        });
+        bench::report(label.c_str(), "unaligned + scalar tail", double(count) * kernel_passes / unalignedSeconds / 1e9, "Gelements/s");
+
+        AlignedVector<float> alignedX;
+        AlignedVector<float> alignedY;
+        alignedX.resize(count);
+        alignedY.resize(count);
+        std::fill(alignedX.begin(), alignedX.end(), 1.0f);
+
+        const auto paddedCount = AlignedVector<float>::allocator_type::padded_count(alignedX.capacity());
+        const auto alignedSeconds = bench::best_of(5, [&] {
+            for (std::size_t pass = 0; pass != kernel_passes; ++pass)
+            {
+                axpy_aligned(1e-6f, alignedX.data(), alignedY.data(), paddedCount);
+                bench::do_not_optimize(alignedY.data()[0]);
+            }
+        });
+        bench::report(label.c_str(), "AlignedVector, no tail", double(count) * kernel_passes / alignedSeconds / 1e9, "Gelements/s");
+    }
+}
+
+// Per-thread Vectors stored next to each other: plain Vector headers share cache lines, so every
+// push_back invalidates the neighbours' line; CacheLinePadded gives each header its own line.
+STL_CONTAINER_IMPL_BENCH(per_thread_append)
+{
+    const auto hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("  (%u hardware threads)\n", hardwareThreads);
+
+    for (unsigned threadCount = 1; threadCount <= std::max(4u, hardwareThreads); threadCount *= 2)
+    {
+        const auto label = std::to_string(threadCount) + " threads";
+
+        const auto packed = appends_per_second<Vector<int>>(threadCount, [](Vector<int>& vector) -> Vector<int>& { return vector; });
+        bench::report(label.c_str(), "Vector<Vector<int>>", packed / 1e6, "Mappends/s");
+
+        const auto padded = appends_per_second<CacheLinePadded<Vector<int>>>(threadCount, [](CacheLinePadded<Vector<int>>& vector) -> Vector<int>& { return *vector; });
+        bench::report(label.c_str(), "CacheLinePadded", padded / 1e6, "Mappends/s");
+    }
+}
@@ -0,0 +1,72 @@
+#include "bench.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using stl_container_impl::Vector;
+
+namespace
+{
+    constexpr std::size_t element_count = 1 << 20;
+
+    // out = in * 3 + 1, appended to out. With push_back every iteration carries the capacity
+    // check and the reallocation call, which keeps the loop scalar; the appender's emplace is a
+    // plain store, so the loop vectorizes.
+    void transform_push_back(const std::int32_t* in, Vector<std::int32_t>& out, std::size_t first, std::size_t last)
+    {
+        for (auto i = first; i != last; ++i)
+            out.push_back(in[i] * 3 + 1);
+    }
+
+    void transform_append(const std::int32_t* in, Vector<std::int32_t>& out, std::size_t first, std::size_t last)
+    {
+        auto appender = out.reserve_append(last - first);
+        for (auto i = first; i != last; ++i)
+            appender.emplace(in[i] * 3 + 1);
+    }
+
+    // Appends element_count transformed values in batches of batchSize, reusing out's capacity.
+    template <typename Transform>
+    double values_per_second(const Vector<std::int32_t>& in, std::size_t batchSize, bool reserveFirst, Transform&& transform)
+    {
+        Vector<std::int32_t> out;
+        out.reserve(element_count);
+
+        const auto seconds = bench::best_of(20, [&] {
+            out.clear();
+            for (std::size_t first = 0; first != element_count; first += batchSize)
+            {
+                if (reserveFirst)
+                    out.reserve(first + batchSize);
+                transform(in.data(), out, first, first + batchSize);
+            }
+            bench::do_not_optimize(out.data()[element_count - 1]);
+        });
+        return element_count / seconds;
+    }
+
+} // namespace
+
+// Transform-and-append of trivially copyable values: reserve() + push_back against
+// reserve_append() + BackAppender::emplace, for one large batch and for many small ones.
+STL_CONTAINER_IMPL_BENCH(back_appender)
+{
+    Vector<std::int32_t> in;
+    in.resize(element_count);
+    for (std::size_t i = 0; i != element_count; ++i)
+        in[i] = static_cast<std::int32_t>(i);
+
+    for (const std::size_t batchSize : { element_count, std::size_t(64) })
+    {
+        const auto label = "int32, batches of " + std::to_string(batchSize);
+
+        const auto pushBack = values_per_second(in, batchSize, true, transform_push_back);
+        bench::report(label.c_str(), "reserve + push_back", pushBack / 1e6, "Mvalues/s");
+
+        const auto append = values_per_second(in, batchSize, false, transform_append);
+        bench::report(label.c_str(), "reserve_append + emplace", append / 1e6, "Mvalues/s");
+    }
+}
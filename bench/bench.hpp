@@ -0,0 +1,71 @@
+#pragma once
+
+// Minimal benchmark harness: each bench/*.cpp registers functions with STL_CONTAINER_IMPL_BENCH,
+// bench/main.cpp runs them (all, or those whose name contains argv[1]).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+    using BenchFn = void (*)();
+
+    inline std::vector<std::pair<std::string, BenchFn>>& registry()
+    {
+        static std::vector<std::pair<std::string, BenchFn>> benchmarks;
+        return benchmarks;
+    }
+
+    struct Registrar
+    {
+        Registrar(const char* name, BenchFn fn)
+        {
+            registry().emplace_back(name, fn);
+        }
+    };
+
+    // Keeps value observable so the computation producing it is not optimized away.
+    template <typename T>
+    inline void do_not_optimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T* sink;
+        sink = &value;
+#endif
+    }
+
+    // Best wall-clock time of repetitions runs of fn, in seconds.
+    template <typename Fn>
+    double best_of(int repetitions, Fn&& fn)
+    {
+        double best = 1e300;
+        for (int i = 0; i != repetitions; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+
+    inline void report(const char* name, const char* metric, double value, const char* unit)
+    {
+        std::printf("  %-40s %-24s %12.2f %s\n", name, metric, value, unit);
+    }
+
+} // namespace bench
+
+#define STL_CONTAINER_IMPL_BENCH_CONCAT_(a, b) a##b
+#define STL_CONTAINER_IMPL_BENCH_CONCAT(a, b) STL_CONTAINER_IMPL_BENCH_CONCAT_(a, b)
+
+#define STL_CONTAINER_IMPL_BENCH(name)                                                                 \
+    static void name();                                                                               \
+    static const bench::Registrar STL_CONTAINER_IMPL_BENCH_CONCAT(name, _registrar)(#name, &name); \
+    static void name()
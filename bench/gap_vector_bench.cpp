@@ -0,0 +1,58 @@
+#include "bench.hpp"
+#include "gap_vector.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+using stl_container_impl::GapVector;
+using stl_container_impl::Vector;
+
+namespace
+{
+    constexpr std::size_t insert_count = 1000000;
+    constexpr std::size_t burst_length = 100;
+
+    // Editor-like workload: bursts of burst_length consecutive inserts, each burst starting at
+    // a random position of the sequence built so far.
+    template <typename Insert>
+    void clustered_inserts(Insert&& insert)
+    {
+        std::mt19937_64 rng(7);
+
+        std::size_t size = 0;
+        std::size_t cursor = 0;
+        for (std::size_t i = 0; i != insert_count; ++i)
+        {
+            if (i % burst_length == 0)
+                cursor = std::uniform_int_distribution<std::size_t>(0, size)(rng);
+
+            insert(cursor, static_cast<std::uint32_t>(i));
+            ++cursor;
+            ++size;
+        }
+    }
+
+} // namespace
+
+STL_CONTAINER_IMPL_BENCH(gap_vector_clustered_inserts)
+{
+    const auto gapSeconds = bench::best_of(3, [] {
+        GapVector<std::uint32_t> values;
+        clustered_inserts([&](std::size_t pos, std::uint32_t value) { values.insert(pos, value); });
+        bench::do_not_optimize(values[0]);
+    });
+    bench::report("1M inserts, bursts of 100", "GapVector::insert", gapSeconds * 1e3, "ms");
+
+    // Quadratic: every insert shifts the tail, so a single run is enough. Reserved up front,
+    // otherwise each insert into a full Vector reallocates to exactly size() + 1.
+    const auto vectorSeconds = bench::best_of(1, [] {
+        Vector<std::uint32_t> values;
+        values.reserve(insert_count);
+        clustered_inserts([&](std::size_t pos, std::uint32_t value) { values.insert(values.begin() + pos, value); });
+        bench::do_not_optimize(values[0]);
+    });
+    bench::report("1M inserts, bursts of 100", "Vector::insert", vectorSeconds * 1e3, "ms");
+    bench::report("1M inserts, bursts of 100", "speedup", vectorSeconds / gapSeconds, "x");
+}
@@ -0,0 +1,45 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if STL_CONTAINER_IMPL_PERF_COUNTERS
+#include "perf_counters.hpp"
+#include <iostream>
+#endif
+
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : "";
+
+#if STL_CONTAINER_IMPL_PERF_COUNTERS
+    // Instrumented build: record unless explicitly switched off, and report per benchmark.
+    // Timings then include the counter reads.
+    namespace perf = stl_container_impl::perf;
+
+    const char* env = std::getenv("STL_CONTAINER_IMPL_PERF");
+    perf::set_enabled(env == nullptr || std::strcmp(env, "0") != 0);
+#endif
+
+    auto benchmarks = bench::registry();
+    std::sort(benchmarks.begin(), benchmarks.end());
+
+    for (const auto& [name, fn] : benchmarks)
+    {
+        if (std::strstr(name.c_str(), filter) == nullptr)
+            continue;
+
+        std::printf("%s\n", name.c_str());
+        fn();
+
+#if STL_CONTAINER_IMPL_PERF_COUNTERS
+        std::fflush(stdout);
+        perf::report(std::cout);
+        perf::reset();
+#endif
+    }
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "bench.hpp"
+#include "packed_int_vector.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+using stl_container_impl::PackedIntVector;
+using stl_container_impl::Vector;
+
+namespace
+{
+    constexpr std::size_t value_count = 1 << 20;
+
+    template <typename Generator>
+    void run(const char* name, Generator&& next)
+    {
+        PackedIntVector<> packed;
+        Vector<std::uint64_t> raw;
+        for (std::size_t i = 0; i != value_count; ++i)
+        {
+            const auto value = next();
+            packed.push_back(value);
+            raw.push_back(value);
+        }
+        packed.shrink_to_fit();
+
+        bench::report(name, "compression ratio", double(value_count * sizeof(std::uint64_t)) / packed.memory_usage(), "x");
+
+        Vector<std::uint64_t> out;
+        const auto decodeSeconds = bench::best_of(10, [&] {
+            packed.decode(out);
+            bench::do_not_optimize(out.data()[value_count - 1]);
+        });
+        bench::report(name, "decode", value_count / decodeSeconds / 1e6, "Mvalues/s");
+
+        const auto copySeconds = bench::best_of(10, [&] {
+            std::memcpy(out.data(), raw.data(), value_count * sizeof(std::uint64_t));
+            bench::do_not_optimize(out.data()[value_count - 1]);
+        });
+        bench::report(name, "memcpy of raw values", value_count / copySeconds / 1e6, "Mvalues/s");
+
+        const auto accessSeconds = bench::best_of(5, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i != value_count; ++i)
+            {
+                sum += packed[i];
+            }
+            bench::do_not_optimize(sum);
+        });
+        bench::report(name, "operator[] scan", value_count / accessSeconds / 1e6, "Mvalues/s");
+    }
+
+} // namespace
+
+STL_CONTAINER_IMPL_BENCH(packed_int_vector)
+{
+    std::mt19937_64 rng(42);
+
+    std::uint64_t current = 1000000;
+    run("sorted, stride 3", [&] { return current += 3; });
+
+    current = 1000000;
+    run("sorted, random stride 0..7", [&] { return current += rng() % 8; });
+
+    run("random below 2^20", [&] { return rng() % (1 << 20); });
+
+    run("random 64-bit", [&] { return rng(); });
+}
@@ -0,0 +1,129 @@
+#include "bench.hpp"
+#include "priority_queue.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+using stl_container_impl::PriorityQueue;
+
+namespace
+{
+    constexpr std::size_t operation_count = 4000000;
+
+    // Deadlines in ticks; a min-heap keeps the earliest one on top.
+    using Deadline = std::uint64_t;
+
+    std::vector<Deadline> initial_deadlines(std::size_t count)
+    {
+        std::mt19937_64 rng(11);
+        std::uniform_int_distribution<Deadline> delay(1, 1 << 16);
+
+        std::vector<Deadline> deadlines(count);
+        for (auto& deadline : deadlines)
+            deadline = delay(rng);
+        return deadlines;
+    }
+
+    // Timer-wheel-like steady state: the earliest timer fires and is re-armed at "now" plus a
+    // random delay, so the number of pending timers stays constant.
+    template <typename Expire>
+    void fire_and_rearm(Expire&& expire)
+    {
+        std::mt19937_64 rng(13);
+        std::uniform_int_distribution<Deadline> delay(1, 1 << 16);
+
+        for (std::size_t i = 0; i != operation_count; ++i)
+            expire(delay(rng));
+    }
+
+    void run(std::size_t pendingTimers)
+    {
+        const auto deadlines = initial_deadlines(pendingTimers);
+        const auto label = std::to_string(pendingTimers) + " pending timers";
+
+        const auto stdSeconds = bench::best_of(3, [&] {
+            std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> timers(deadlines.begin(), deadlines.end());
+            fire_and_rearm([&](Deadline delay) {
+                const auto now = timers.top();
+                timers.pop();
+                timers.push(now + delay);
+            });
+            bench::do_not_optimize(timers.top());
+        });
+        bench::report(label.c_str(), "std::priority_queue", operation_count / stdSeconds / 1e6, "Mops/s");
+
+        const auto binarySeconds = bench::best_of(3, [&] {
+            PriorityQueue<Deadline, std::greater<Deadline>, 2> timers;
+            timers.push_range(deadlines.begin(), deadlines.end());
+            fire_and_rearm([&](Deadline delay) {
+                const auto now = timers.top();
+                timers.pop();
+                timers.push(now + delay);
+            });
+            bench::do_not_optimize(timers.top());
+        });
+        bench::report(label.c_str(), "D=2 pop + push", operation_count / binarySeconds / 1e6, "Mops/s");
+
+        const auto quaternarySeconds = bench::best_of(3, [&] {
+            PriorityQueue<Deadline, std::greater<Deadline>, 4> timers;
+            timers.push_range(deadlines.begin(), deadlines.end());
+            fire_and_rearm([&](Deadline delay) {
+                const auto now = timers.top();
+                timers.pop();
+                timers.push(now + delay);
+            });
+            bench::do_not_optimize(timers.top());
+        });
+        bench::report(label.c_str(), "D=4 pop + push", operation_count / quaternarySeconds / 1e6, "Mops/s");
+
+        const auto fusedSeconds = bench::best_of(3, [&] {
+            PriorityQueue<Deadline, std::greater<Deadline>, 4> timers;
+            timers.push_range(deadlines.begin(), deadlines.end());
+            fire_and_rearm([&](Deadline delay) { timers.pop_push(timers.top() + delay); });
+            bench::do_not_optimize(timers.top());
+        });
+        bench::report(label.c_str(), "D=4 pop_push", operation_count / fusedSeconds / 1e6, "Mops/s");
+    }
+
+} // namespace
+
+STL_CONTAINER_IMPL_BENCH(priority_queue_timers)
+{
+    run(1000);
+    run(100000);
+    run(1000000);
+}
+
+// Loading a large batch of timers at once: O(n) heapify against the range constructor, which
+// heapifies as well, and against pushing one by one.
+STL_CONTAINER_IMPL_BENCH(priority_queue_bulk_load)
+{
+    const auto deadlines = initial_deadlines(operation_count);
+    const char* label = "4M timers";
+
+    const auto stdSeconds = bench::best_of(3, [&] {
+        std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> timers(deadlines.begin(), deadlines.end());
+        bench::do_not_optimize(timers.top());
+    });
+    bench::report(label, "std::priority_queue(first, last)", stdSeconds * 1e3, "ms");
+
+    const auto rangeSeconds = bench::best_of(3, [&] {
+        PriorityQueue<Deadline, std::greater<Deadline>, 4> timers;
+        timers.push_range(deadlines.begin(), deadlines.end());
+        bench::do_not_optimize(timers.top());
+    });
+    bench::report(label, "D=4 push_range", rangeSeconds * 1e3, "ms");
+
+    const auto pushSeconds = bench::best_of(3, [&] {
+        PriorityQueue<Deadline, std::greater<Deadline>, 4> timers;
+        timers.reserve(deadlines.size());
+        for (const auto deadline : deadlines)
+            timers.push(deadline);
+        bench::do_not_optimize(timers.top());
+    });
+    bench::report(label, "D=4 push one by one", pushSeconds * 1e3, "ms");
+}
@@ -0,0 +1,144 @@
+#include "bench.hpp"
+#include "shared_vector.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using stl_container_impl::AtomicSharedVector;
+using stl_container_impl::SharedVector;
+using stl_container_impl::Vector;
+
+namespace
+{
+    constexpr std::size_t element_count = 64;
+    constexpr auto run_time = std::chrono::milliseconds(200);
+    constexpr auto publish_interval = std::chrono::microseconds(100);
+
+    // Runs readerCount threads, each calling the function returned by makeReader() in a loop, while
+    // the calling thread calls writeOnce() every publish_interval. Returns total reads per second.
+    template <typename MakeReader, typename WriteOnce>
+    double reads_per_second(unsigned readerCount, MakeReader&& makeReader, WriteOnce&& writeOnce)
+    {
+        std::atomic<bool> start{ false };
+        std::atomic<bool> stop{ false };
+        std::atomic<std::uint64_t> totalReads{ 0 };
+
+        std::vector<std::thread> readers;
+        for (unsigned i = 0; i != readerCount; ++i)
+        {
+            readers.emplace_back([&] {
+                auto readOnce = makeReader();
+                while (!start.load())
+                    std::this_thread::yield();
+
+                std::uint64_t reads = 0;
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    readOnce();
+                    ++reads;
+                }
+                totalReads.fetch_add(reads);
+            });
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        start.store(true);
+        for (auto now = begin; now - begin < run_time; now = std::chrono::steady_clock::now())
+        {
+            writeOnce();
+            std::this_thread::sleep_for(publish_interval);
+        }
+        stop.store(true);
+
+        for (auto& reader : readers)
+            reader.join();
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        return totalReads.load() / elapsed.count();
+    }
+
+    std::uint64_t sum(const SharedVector<std::uint64_t>& values)
+    {
+        std::uint64_t result = 0;
+        for (const auto value : values)
+            result += value;
+        return result;
+    }
+
+} // namespace
+
+// Total read throughput with 1..N readers while one writer keeps publishing new versions.
+// Reads scale with the reader count as long as readers do not share cache lines; the
+// mutex-protected std::vector is the baseline that serializes them.
+STL_CONTAINER_IMPL_BENCH(shared_vector_reader_scaling)
+{
+    const auto hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("  (%u hardware threads)\n", hardwareThreads);
+
+    std::vector<unsigned> readerCounts;
+    for (unsigned count = 1; count <= std::max(8u, hardwareThreads); count *= 2)
+        readerCounts.push_back(count);
+
+    for (const auto readerCount : readerCounts)
+    {
+        const auto label = std::to_string(readerCount) + " readers";
+
+        {
+            using Published = AtomicSharedVector<std::uint64_t>;
+            Vector<std::uint64_t> initial;
+            initial.resize(element_count);
+            Published published{ SharedVector<std::uint64_t>(std::move(initial)) };
+
+            std::uint64_t version = 1;
+            auto writer = published.load_for_writer();
+            const auto rate = reads_per_second(
+                readerCount,
+                [&] {
+                    return [reader = std::make_unique<Published::Reader>(published)] {
+                        bench::do_not_optimize(reader->read(sum));
+                    };
+                },
+                [&] {
+                    writer.set(version % element_count, version);
+                    ++version;
+                    published.publish(writer);
+                });
+            bench::report(label.c_str(), "AtomicSharedVector", rate / 1e6, "Mreads/s");
+        }
+
+        {
+            std::vector<std::uint64_t> values(element_count);
+            std::mutex mutex;
+
+            std::uint64_t version = 1;
+            const auto rate = reads_per_second(
+                readerCount,
+                [&] {
+                    return [&] {
+                        std::uint64_t result = 0;
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            for (const auto value : values)
+                                result += value;
+                        }
+                        bench::do_not_optimize(result);
+                    };
+                },
+                [&] {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    values[version % element_count] = version;
+                    ++version;
+                });
+            bench::report(label.c_str(), "mutex + std::vector", rate / 1e6, "Mreads/s");
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include "bench.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using stl_container_impl::String;
+using stl_container_impl::Vector;
+
+namespace
+{
+    constexpr std::size_t record_count = 500000;
+
+    // CSV-like input: an id, a short name, a status word and a free-text comment per line. Most
+    // fields fit 15 characters (std::string's inline buffer with libstdc++), names up to 23 fit
+    // String's, comments need the heap in both.
+    std::string make_input()
+    {
+        static const char* const statuses[] = { "ok", "pending", "failed", "retrying" };
+
+        std::mt19937 rng(17);
+        std::string input;
+        for (std::size_t i = 0; i != record_count; ++i)
+        {
+            input += std::to_string(i);
+            input += ',';
+            input.append(8 + rng() % 16, char('a' + rng() % 26));
+            input += ',';
+            input += statuses[rng() % 4];
+            input += ',';
+            input.append(24 + rng() % 40, char('a' + rng() % 26));
+            input += '\n';
+        }
+        return input;
+    }
+
+    // Splits input into fields and stores every field, then counts the fields equal to "failed".
+    template <typename Fields>
+    std::size_t parse_and_store(std::string_view input, Fields& fields)
+    {
+        std::size_t start = 0;
+        for (std::size_t i = 0; i != input.size(); ++i)
+        {
+            if (input[i] == ',' || input[i] == '\n')
+            {
+                fields.emplace_back(input.data() + start, i - start);
+                start = i + 1;
+            }
+        }
+
+        std::size_t failed = 0;
+        for (const auto& field : fields)
+            failed += field == "failed";
+        return failed;
+    }
+
+} // namespace
+
+STL_CONTAINER_IMPL_BENCH(string_parse_and_store)
+{
+    const auto input = make_input();
+    const auto fieldCount = record_count * 4;
+    const char* label = "500K CSV lines, 2M fields";
+
+    const auto stdSeconds = bench::best_of(5, [&] {
+        std::vector<std::string> fields;
+        bench::do_not_optimize(parse_and_store(input, fields));
+    });
+    bench::report(label, "std::vector<std::string>", stdSeconds * 1e9 / fieldCount, "ns/field");
+
+    const auto stringSeconds = bench::best_of(5, [&] {
+        Vector<String> fields;
+        bench::do_not_optimize(parse_and_store(input, fields));
+    });
+    bench::report(label, "Vector<String>", stringSeconds * 1e9 / fieldCount, "ns/field");
+    bench::report(label, "speedup", stdSeconds / stringSeconds, "x");
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "vector.hpp"
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace stl_container_impl
+{
+    /*---------------------------------------------------------------------------------------------
+     * Allocator returning storage aligned to Alignment bytes (e.g. 32 for AVX2, 64 for AVX-512 or
+     * a cache line) whose size is rounded up to a multiple of Alignment.
+     *
+     * Because of the rounding, a buffer of n elements is readable and writable up to
+     * padded_count(n) elements. SIMD kernels over trivially copyable T can therefore run whole
+     * vector-width iterations up to padded_count(capacity()) without a scalar tail; slots past
+     * size() hold unspecified values.
+     -----------------------------------------------------------------------------------------------*/
+    template <class T, std::size_t Alignment = 64>
+    class AlignedAllocator
+    {
+        static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+        static_assert(Alignment >= alignof(T), "Alignment must not be weaker than alignof(T)");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using propagate_on_container_move_assignment = std::true_type;
+        using is_always_equal = std::true_type;
+
+        static constexpr std::size_t alignment = Alignment;
+
+        template <class U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, (Alignment > alignof(U) ? Alignment : alignof(U))>;
+        };
+
+    public:
+        AlignedAllocator() noexcept = default;
+
+        template <class U, std::size_t OtherAlignment>
+        AlignedAllocator(const AlignedAllocator<U, OtherAlignment>&) noexcept
+        {
+        }
+
+        T* allocate(size_type count)
+        {
+            if (count > max_size())
+                throw std::bad_array_new_length();
+
+            return static_cast<T*>(::operator new(padded_bytes(count), std::align_val_t(Alignment)));
+        }
+
+        void deallocate(T* ptr, size_type count) noexcept
+        {
+            ::operator delete(ptr, padded_bytes(count), std::align_val_t(Alignment));
+        }
+
+        size_type max_size() const noexcept
+        {
+            return (std::numeric_limits<size_type>::max() - Alignment) / sizeof(T);
+        }
+
+        // Number of elements that fit into the storage allocated for count elements.
+        static constexpr size_type padded_count(size_type count) noexcept
+        {
+            return padded_bytes(count) / sizeof(T);
+        }
+
+        template <class U, std::size_t OtherAlignment>
+        bool operator==(const AlignedAllocator<U, OtherAlignment>&) const noexcept
+        {
+            return true;
+        }
+
+        template <class U, std::size_t OtherAlignment>
+        bool operator!=(const AlignedAllocator<U, OtherAlignment>&) const noexcept
+        {
+            return false;
+        }
+
+    private:
+        static constexpr size_type padded_bytes(size_type count) noexcept
+        {
+            return (count * sizeof(T) + Alignment - 1) & ~(Alignment - 1);
+        }
+    };
+
+    // Vector whose data() is Alignment-aligned and padded to a multiple of Alignment bytes.
+    template <class T, std::size_t Alignment = 64>
+    using AlignedVector = Vector<T, AlignedAllocator<T, Alignment>>;
+
+    /*---------------------------------------------------------------------------------------------
+     * Wraps a value so that it occupies whole cache lines on its own.
+     *
+     * Useful for per-thread objects stored next to each other, e.g.
+     * Vector<CacheLinePadded<Vector<int>>> with one element per thread: every thread appends to
+     * its own Vector, and the headers (begin/end/capacity pointers) written on each append no
+     * longer share a cache line with another thread's, which avoids false sharing.
+     -----------------------------------------------------------------------------------------------*/
+    template <class T, std::size_t CacheLineSize = 64>
+    struct alignas(CacheLineSize) CacheLinePadded
+    {
+        T value;
+
+        T& operator*() noexcept
+        {
+            return value;
+        }
+
+        const T& operator*() const noexcept
+        {
+            return value;
+        }
+
+        T* operator->() noexcept
+        {
+            return &value;
+        }
+
+        const T* operator->() const noexcept
+        {
+            return &value;
+        }
+    };
+
+} // namespace stl_container_impl
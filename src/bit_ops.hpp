@@ -0,0 +1,56 @@
+#pragma once
+
+// Portable wrappers over the bit manipulation intrinsics used by the packed containers.
+// On x86-64 they compile down to popcnt / tzcnt / lzcnt when the target supports them.
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace stl_container_impl
+{
+    namespace detail
+    {
+        inline unsigned popcount64(std::uint64_t word) noexcept
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            return static_cast<unsigned>(__popcnt64(word));
+#else
+            return static_cast<unsigned>(__builtin_popcountll(word));
+#endif
+        }
+
+        // Index of the lowest set bit. word must not be zero.
+        inline unsigned count_trailing_zeros64(std::uint64_t word) noexcept
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanForward64(&index, word);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+        }
+
+        // Number of bits needed to represent word; 0 for 0.
+        inline unsigned bit_width64(std::uint64_t word) noexcept
+        {
+            if (word == 0)
+            {
+                return 0;
+            }
+
+#if defined(_MSC_VER) && !defined(__clang__)
+            unsigned long index;
+            _BitScanReverse64(&index, word);
+            return static_cast<unsigned>(index) + 1;
+#else
+            return 64 - static_cast<unsigned>(__builtin_clzll(word));
+#endif
+        }
+
+    } // namespace detail
+
+} // namespace stl_container_impl
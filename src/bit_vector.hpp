@@ -0,0 +1,419 @@
+#pragma once
+
+#include "bit_ops.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace stl_container_impl
+{
+    /*---------------------------------------------------------------------------------------------
+     * Dynamic bitset packing 64 flags per word, a compact replacement for Vector<bool>.
+     *
+     * Invariant: bits of the last word beyond size() are always zero, so count(), find_first()
+     * and comparisons can work on whole words without masking the tail.
+     -----------------------------------------------------------------------------------------------*/
+    template <class Allocator = std::allocator<std::uint64_t>>
+    class BitVector
+    {
+    public:
+        using word_type = std::uint64_t;
+        using size_type = std::size_t;
+        using allocator_type = Allocator;
+
+        static constexpr size_type bits_per_word = 64;
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        class reference
+        {
+        public:
+            reference(word_type* word, word_type mask) noexcept
+                : m_word(word)
+                , m_mask(mask)
+            {
+            }
+
+            operator bool() const noexcept
+            {
+                return (*m_word & m_mask) != 0;
+            }
+
+            reference& operator=(bool value) noexcept
+            {
+                if (value)
+                    *m_word |= m_mask;
+                else
+                    *m_word &= ~m_mask;
+
+                return *this;
+            }
+
+            reference& operator=(const reference& other) noexcept
+            {
+                return *this = static_cast<bool>(other);
+            }
+
+            void flip() noexcept
+            {
+                *m_word ^= m_mask;
+            }
+
+        private:
+            word_type* m_word;
+            word_type m_mask;
+        };
+
+    public:
+        BitVector() = default;
+
+        explicit BitVector(size_type count, bool value = false)
+        {
+            resize(count, value);
+        }
+
+        void reserve(size_type count)
+        {
+            m_words.reserve(words_for(count));
+        }
+
+        void resize(size_type count, bool value = false)
+        {
+            const auto oldSize = m_size;
+            if (count < oldSize)
+            {
+                m_words.resize(words_for(count));
+                m_size = count;
+                clear_tail();
+                return;
+            }
+
+            m_words.resize(words_for(count)); // new words are value-initialized to zero
+            m_size = count;
+
+            if (value)
+            {
+                set(oldSize, count);
+            }
+        }
+
+        void push_back(bool value)
+        {
+            const auto bit = m_size % bits_per_word;
+            if (bit == 0)
+            {
+                m_words.push_back(word_type(value));
+            }
+            else if (value)
+            {
+                m_words.back() |= word_type(1) << bit;
+            }
+
+            ++m_size;
+        }
+
+        void pop_back() noexcept
+        {
+            --m_size;
+            if (m_size % bits_per_word == 0)
+            {
+                m_words.pop_back();
+            }
+            else
+            {
+                clear_tail();
+            }
+        }
+
+        void clear() noexcept
+        {
+            m_words.clear();
+            m_size = 0;
+        }
+
+    public:
+        bool test(size_type pos) const noexcept
+        {
+            return (m_words.data()[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+        }
+
+        bool operator[](size_type pos) const noexcept
+        {
+            return test(pos);
+        }
+
+        reference operator[](size_type pos) noexcept
+        {
+            return reference{ m_words.data() + pos / bits_per_word, bit_mask(pos) };
+        }
+
+        bool at(size_type pos) const
+        {
+            if (pos >= m_size)
+            {
+                throw std::out_of_range("BitVector::at");
+            }
+
+            return test(pos);
+        }
+
+        void set(size_type pos) noexcept
+        {
+            m_words.data()[pos / bits_per_word] |= bit_mask(pos);
+        }
+
+        void reset(size_type pos) noexcept
+        {
+            m_words.data()[pos / bits_per_word] &= ~bit_mask(pos);
+        }
+
+        void flip(size_type pos) noexcept
+        {
+            m_words.data()[pos / bits_per_word] ^= bit_mask(pos);
+        }
+
+        // Sets bits in [first, last).
+        void set(size_type first, size_type last) noexcept
+        {
+            apply_range(first, last, [](word_type& word, word_type mask) { word |= mask; });
+        }
+
+        // Clears bits in [first, last).
+        void reset(size_type first, size_type last) noexcept
+        {
+            apply_range(first, last, [](word_type& word, word_type mask) { word &= ~mask; });
+        }
+
+        void set() noexcept
+        {
+            set(0, m_size);
+        }
+
+        void reset() noexcept
+        {
+            std::fill(m_words.begin(), m_words.end(), word_type(0));
+        }
+
+        size_type count() const noexcept
+        {
+            const auto words = m_words.data();
+            const auto wordCount = m_words.size();
+
+            size_type result = 0;
+            for (size_type i = 0; i != wordCount; ++i)
+            {
+                result += detail::popcount64(words[i]);
+            }
+
+            return result;
+        }
+
+        bool any() const noexcept
+        {
+            return find_first() != npos;
+        }
+
+        bool none() const noexcept
+        {
+            return !any();
+        }
+
+        bool all() const noexcept
+        {
+            return count() == m_size;
+        }
+
+        // Position of the first set bit or npos.
+        size_type find_first() const noexcept
+        {
+            return find_from_word(0);
+        }
+
+        // Position of the first set bit strictly after pos or npos.
+        size_type find_next(size_type pos) const noexcept
+        {
+            ++pos;
+            if (pos >= m_size)
+            {
+                return npos;
+            }
+
+            const auto index = pos / bits_per_word;
+            const auto word = m_words.data()[index] & (~word_type(0) << (pos % bits_per_word));
+            if (word != 0)
+            {
+                return index * bits_per_word + detail::count_trailing_zeros64(word);
+            }
+
+            return find_from_word(index + 1);
+        }
+
+    public:
+        /*---------------------------------------------------------------------------------------------
+         * Bulk word-wise operations. Both operands must have the same size().
+         * The loops run over raw word pointers so the compiler can vectorize them.
+         -----------------------------------------------------------------------------------------------*/
+
+        BitVector& operator&=(const BitVector& other)
+        {
+            combine(other, "BitVector::operator&=", [](word_type a, word_type b) { return a & b; });
+            return *this;
+        }
+
+        BitVector& operator|=(const BitVector& other)
+        {
+            combine(other, "BitVector::operator|=", [](word_type a, word_type b) { return a | b; });
+            return *this;
+        }
+
+        BitVector& operator^=(const BitVector& other)
+        {
+            combine(other, "BitVector::operator^=", [](word_type a, word_type b) { return a ^ b; });
+            return *this;
+        }
+
+        // this = this & ~other
+        BitVector& and_not(const BitVector& other)
+        {
+            combine(other, "BitVector::and_not", [](word_type a, word_type b) { return a & ~b; });
+            return *this;
+        }
+
+        bool operator==(const BitVector& other) const noexcept
+        {
+            return m_size == other.m_size && std::equal(m_words.data(), m_words.data() + m_words.size(), other.m_words.data());
+        }
+
+        bool operator!=(const BitVector& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+    public:
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_words.capacity() * bits_per_word;
+        }
+
+        size_type word_count() const noexcept
+        {
+            return m_words.size();
+        }
+
+        // Raw words for bulk processing. Bits past size() in the last word must stay zero:
+        // count(), all(), find_first() and operator== rely on it.
+        word_type* words() noexcept
+        {
+            return m_words.data();
+        }
+
+        const word_type* words() const noexcept
+        {
+            return m_words.data();
+        }
+
+        Allocator get_allocator() const noexcept
+        {
+            return m_words.get_allocator();
+        }
+
+    private:
+        static size_type words_for(size_type bits) noexcept
+        {
+            return (bits + bits_per_word - 1) / bits_per_word;
+        }
+
+        static word_type bit_mask(size_type pos) noexcept
+        {
+            return word_type(1) << (pos % bits_per_word);
+        }
+
+        void clear_tail() noexcept
+        {
+            const auto bit = m_size % bits_per_word;
+            if (bit != 0)
+            {
+                m_words.back() &= (word_type(1) << bit) - 1;
+            }
+        }
+
+        size_type find_from_word(size_type index) const noexcept
+        {
+            const auto words = m_words.data();
+            const auto wordCount = m_words.size();
+
+            for (; index < wordCount; ++index)
+            {
+                if (words[index] != 0)
+                {
+                    return index * bits_per_word + detail::count_trailing_zeros64(words[index]);
+                }
+            }
+
+            return npos;
+        }
+
+        template <typename Op>
+        void apply_range(size_type first, size_type last, Op op) noexcept
+        {
+            if (first >= last)
+            {
+                return;
+            }
+
+            const auto words = m_words.data();
+            const auto firstWord = first / bits_per_word;
+            const auto lastWord = (last - 1) / bits_per_word;
+            const auto headMask = ~word_type(0) << (first % bits_per_word);
+            const auto tailMask = ~word_type(0) >> (bits_per_word - 1 - (last - 1) % bits_per_word);
+
+            if (firstWord == lastWord)
+            {
+                op(words[firstWord], headMask & tailMask);
+                return;
+            }
+
+            op(words[firstWord], headMask);
+            for (auto i = firstWord + 1; i != lastWord; ++i)
+            {
+                op(words[i], ~word_type(0));
+            }
+            op(words[lastWord], tailMask);
+        }
+
+        template <typename Op>
+        void combine(const BitVector& other, const char* what, Op op)
+        {
+            if (m_size != other.m_size)
+            {
+                throw std::invalid_argument(what);
+            }
+
+            const auto dst = m_words.data();
+            const auto src = other.m_words.data();
+            const auto wordCount = m_words.size();
+
+            for (size_type i = 0; i != wordCount; ++i)
+            {
+                dst[i] = op(dst[i], src[i]);
+            }
+        }
+
+    private:
+        Vector<word_type, Allocator> m_words;
+        size_type m_size = 0;
+    };
+
+} // namespace stl_container_impl
@@ -0,0 +1,50 @@
+#pragma once
+
+// Build configuration shared by the containers.
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// C++20 allows allocation in constant expressions; the containers are constexpr there.
+#if defined(__cpp_constexpr_dynamic_alloc) && __cpp_constexpr_dynamic_alloc >= 201907L
+#define STL_CONTAINER_IMPL_CONSTEXPR20 constexpr
+#define STL_CONTAINER_IMPL_HAS_CONSTEXPR_ALLOC 1
+#else
+#define STL_CONTAINER_IMPL_CONSTEXPR20
+#define STL_CONTAINER_IMPL_HAS_CONSTEXPR_ALLOC 0
+#endif
+
+// Hardware counter instrumentation of container operations, see perf_counters.hpp.
+#ifndef STL_CONTAINER_IMPL_PERF_COUNTERS
+#define STL_CONTAINER_IMPL_PERF_COUNTERS 0
+#endif
+
+namespace stl_container_impl
+{
+    namespace detail
+    {
+        // std::is_constant_evaluated where available, false before C++20.
+        constexpr bool is_constant_evaluated() noexcept
+        {
+#if defined(__cpp_lib_is_constant_evaluated)
+            return std::is_constant_evaluated();
+#else
+            return false;
+#endif
+        }
+
+        // std::construct_at where available (usable in constant expressions), placement new before C++20.
+        template <typename T, typename... Args>
+        STL_CONTAINER_IMPL_CONSTEXPR20 T* construct_at(T* ptr, Args&&... args)
+        {
+#if STL_CONTAINER_IMPL_HAS_CONSTEXPR_ALLOC
+            return std::construct_at(ptr, std::forward<Args>(args)...);
+#else
+            return ::new (static_cast<void*>(ptr)) T(std::forward<Args>(args)...);
+#endif
+        }
+
+    } // namespace detail
+
+} // namespace stl_container_impl
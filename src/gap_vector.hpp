@@ -0,0 +1,460 @@
+#pragma once
+
+#include "index_iterator.hpp"
+#include "span.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace stl_container_impl
+{
+    /*---------------------------------------------------------------------------------------------
+     * Gap buffer: a single allocation holding the elements in two segments separated by a gap
+     * of uninitialized storage.
+     *
+     *     [ front segment ][ ...gap... ][ back segment ]
+     *
+     * The gap follows the last edit position. Inserting or erasing at the gap is O(1), moving
+     * the gap costs one element move per position travelled, so clustered edits never shift
+     * the whole tail the way Vector::insert does.
+     -----------------------------------------------------------------------------------------------*/
+    template <class T, class Allocator = std::allocator<T>>
+    class GapVector
+    {
+        using Allocator_traits = std::allocator_traits<Allocator>;
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = typename Allocator_traits::size_type;
+        using difference_type = typename Allocator_traits::difference_type;
+        using pointer = typename Allocator_traits::pointer;
+        using const_pointer = typename Allocator_traits::const_pointer;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        using iterator = index_iterator<GapVector, T>;
+        using const_iterator = index_iterator<const GapVector, const T>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    public:
+        GapVector() = default;
+
+        GapVector(const GapVector& other)
+            : m_allocator(Allocator_traits::select_on_container_copy_construction(other.m_allocator))
+        {
+            reserve(other.size());
+
+            const auto segments = other.segments();
+            for (const auto& value : segments.first)
+                emplace_back(value);
+            for (const auto& value : segments.second)
+                emplace_back(value);
+        }
+
+        GapVector(GapVector&& other) noexcept
+            : m_buffer(other.m_buffer)
+            , m_gapBegin(other.m_gapBegin)
+            , m_gapEnd(other.m_gapEnd)
+            , m_endOfStorage(other.m_endOfStorage)
+            , m_allocator(std::move(other.m_allocator))
+        {
+            other.m_buffer = other.m_gapBegin = other.m_gapEnd = other.m_endOfStorage = nullptr;
+        }
+
+        GapVector(std::initializer_list<T> list)
+        {
+            reserve(list.size());
+            for (const auto& value : list)
+                emplace_back(value);
+        }
+
+        ~GapVector()
+        {
+            destroy_and_deallocate();
+        }
+
+        GapVector& operator=(const GapVector& other)
+        {
+            if (std::addressof(other) != this)
+            {
+                GapVector copy(other);
+                swap(copy);
+            }
+
+            return *this;
+        }
+
+        GapVector& operator=(GapVector&& other) noexcept
+        {
+            if (std::addressof(other) != this)
+            {
+                destroy_and_deallocate();
+
+                m_buffer = other.m_buffer;
+                m_gapBegin = other.m_gapBegin;
+                m_gapEnd = other.m_gapEnd;
+                m_endOfStorage = other.m_endOfStorage;
+                m_allocator = std::move(other.m_allocator);
+
+                other.m_buffer = other.m_gapBegin = other.m_gapEnd = other.m_endOfStorage = nullptr;
+            }
+
+            return *this;
+        }
+
+        void swap(GapVector& other) noexcept
+        {
+            using std::swap;
+            swap(m_buffer, other.m_buffer);
+            swap(m_gapBegin, other.m_gapBegin);
+            swap(m_gapEnd, other.m_gapEnd);
+            swap(m_endOfStorage, other.m_endOfStorage);
+            swap(m_allocator, other.m_allocator);
+        }
+
+        void reserve(size_type count)
+        {
+            if (count > capacity())
+            {
+                reallocate(count, gap_position());
+            }
+        }
+
+        template <typename... Args>
+        iterator emplace(size_type pos, Args&&... args)
+        {
+            const auto target = m_buffer + pos;
+            if (m_gapBegin == target && m_gapBegin != m_gapEnd)
+            {
+                // Nothing moves, so args stay valid even if they refer to an element
+                Allocator_traits::construct(m_allocator, m_gapBegin, std::forward<Args>(args)...);
+            }
+            else
+            {
+                // Moving the gap or reallocating would move from an element args may refer to,
+                // so the new element is built first
+                value_type value(std::forward<Args>(args)...);
+
+                if (m_gapBegin == m_gapEnd)
+                {
+                    const auto capacity = this->capacity();
+                    reallocate(capacity + std::max(size_type(1), capacity), pos);
+                }
+                else
+                {
+                    move_gap(pos);
+                }
+
+                Allocator_traits::construct(m_allocator, m_gapBegin, std::move(value));
+            }
+
+            ++m_gapBegin;
+
+            return iterator{ this, static_cast<difference_type>(pos) };
+        }
+
+        iterator insert(size_type pos, const_reference value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator insert(size_type pos, value_type&& value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        iterator insert(const_iterator pos, const_reference value)
+        {
+            return emplace(static_cast<size_type>(pos.index()), value);
+        }
+
+        iterator insert(const_iterator pos, value_type&& value)
+        {
+            return emplace(static_cast<size_type>(pos.index()), std::move(value));
+        }
+
+        template <typename... Args>
+        void emplace_back(Args&&... args)
+        {
+            emplace(size(), std::forward<Args>(args)...);
+        }
+
+        void push_back(const_reference value)
+        {
+            emplace(size(), value);
+        }
+
+        void push_back(value_type&& value)
+        {
+            emplace(size(), std::move(value));
+        }
+
+        void pop_back()
+        {
+            erase(size() - 1);
+        }
+
+        // Erases [pos, pos + count). The gap is left at pos.
+        iterator erase(size_type pos, size_type count = 1)
+        {
+            move_gap(pos);
+            for (; count != 0; --count, ++m_gapEnd)
+            {
+                Allocator_traits::destroy(m_allocator, m_gapEnd);
+            }
+
+            return iterator{ this, static_cast<difference_type>(pos) };
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(static_cast<size_type>(pos.index()));
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            return erase(static_cast<size_type>(first.index()), static_cast<size_type>(last - first));
+        }
+
+        void clear() noexcept
+        {
+            destroy_range(m_buffer, m_gapBegin);
+            destroy_range(m_gapEnd, m_endOfStorage);
+
+            m_gapBegin = m_buffer;
+            m_gapEnd = m_endOfStorage;
+        }
+
+        /*---------------------------------------------------------------------------------------------
+         * Moves the gap so that it starts before the element at pos. An empty gap is repositioned
+         * without moving anything; otherwise every element between the old and new position
+         * is moved across the gap once.
+         -----------------------------------------------------------------------------------------------*/
+        void move_gap(size_type pos)
+        {
+            const auto target = m_buffer + pos;
+            if (m_gapBegin == m_gapEnd)
+            {
+                m_gapBegin = m_gapEnd = target;
+                return;
+            }
+
+            while (m_gapBegin > target)
+            {
+                Allocator_traits::construct(m_allocator, m_gapEnd - 1, std::move_if_noexcept(*(m_gapBegin - 1)));
+                --m_gapEnd;
+                --m_gapBegin;
+                Allocator_traits::destroy(m_allocator, m_gapBegin);
+            }
+
+            while (m_gapBegin < target)
+            {
+                Allocator_traits::construct(m_allocator, m_gapBegin, std::move_if_noexcept(*m_gapEnd));
+                Allocator_traits::destroy(m_allocator, m_gapEnd);
+                ++m_gapBegin;
+                ++m_gapEnd;
+            }
+        }
+
+    public:
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        size_type max_size() const noexcept
+        {
+            return std::numeric_limits<difference_type>::max();
+        }
+
+        size_type size() const noexcept
+        {
+            return capacity() - gap_size();
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_endOfStorage - m_buffer;
+        }
+
+        // Index of the element following the gap.
+        size_type gap_position() const noexcept
+        {
+            return m_gapBegin - m_buffer;
+        }
+
+        size_type gap_size() const noexcept
+        {
+            return m_gapEnd - m_gapBegin;
+        }
+
+        // Elements before and after the gap. Together they hold the whole sequence in order.
+        std::pair<Span<T>, Span<T>> segments() noexcept
+        {
+            return { Span<T>{ m_buffer, gap_position() }, Span<T>{ m_gapEnd, static_cast<size_type>(m_endOfStorage - m_gapEnd) } };
+        }
+
+        std::pair<Span<const T>, Span<const T>> segments() const noexcept
+        {
+            return { Span<const T>{ m_buffer, gap_position() }, Span<const T>{ m_gapEnd, static_cast<size_type>(m_endOfStorage - m_gapEnd) } };
+        }
+
+        iterator begin() noexcept
+        {
+            return iterator{ this, 0 };
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return cbegin();
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return const_iterator{ this, 0 };
+        }
+
+        iterator end() noexcept
+        {
+            return iterator{ this, static_cast<difference_type>(size()) };
+        }
+
+        const_iterator end() const noexcept
+        {
+            return cend();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return const_iterator{ this, static_cast<difference_type>(size()) };
+        }
+
+        Allocator get_allocator() const noexcept
+        {
+            return m_allocator;
+        }
+
+        reference operator[](size_type pos) noexcept
+        {
+            const auto ptr = m_buffer + pos;
+            return ptr < m_gapBegin ? *ptr : *(ptr + gap_size());
+        }
+
+        const_reference operator[](size_type pos) const noexcept
+        {
+            const auto ptr = m_buffer + pos;
+            return ptr < m_gapBegin ? *ptr : *(ptr + gap_size());
+        }
+
+        reference at(size_type pos)
+        {
+            if (pos >= size())
+            {
+                throw std::out_of_range("GapVector::at");
+            }
+
+            return (*this)[pos];
+        }
+
+        const_reference at(size_type pos) const
+        {
+            if (pos >= size())
+            {
+                throw std::out_of_range("GapVector::at");
+            }
+
+            return (*this)[pos];
+        }
+
+        reference front()
+        {
+            return (*this)[0];
+        }
+
+        const_reference front() const
+        {
+            return (*this)[0];
+        }
+
+        reference back()
+        {
+            return (*this)[size() - 1];
+        }
+
+        const_reference back() const
+        {
+            return (*this)[size() - 1];
+        }
+
+    private:
+        // Moves all elements into a new buffer of newCapacity with the gap starting at gapPos.
+        void reallocate(size_type newCapacity, size_type gapPos)
+        {
+            if (newCapacity > max_size())
+                throw std::length_error("GapVector::reserve");
+
+            move_gap(gapPos);
+
+            pointer buffer = Allocator_traits::allocate(m_allocator, newCapacity);
+            pointer endOfStorage = buffer + newCapacity;
+            pointer gapEnd = endOfStorage - (m_endOfStorage - m_gapEnd);
+            pointer finish = buffer;
+            pointer backFinish = gapEnd;
+
+            // Provide strong guarantee
+            try
+            {
+                for (auto src = m_buffer; src != m_gapBegin; ++src, ++finish)
+                    Allocator_traits::construct(m_allocator, finish, std::move_if_noexcept(*src));
+
+                for (auto src = m_gapEnd; src != m_endOfStorage; ++src, ++backFinish)
+                    Allocator_traits::construct(m_allocator, backFinish, std::move_if_noexcept(*src));
+            }
+            catch (...)
+            {
+                destroy_range(buffer, finish);
+                destroy_range(gapEnd, backFinish);
+                Allocator_traits::deallocate(m_allocator, buffer, newCapacity);
+                throw;
+            }
+
+            destroy_and_deallocate();
+
+            m_buffer = buffer;
+            m_gapBegin = finish;
+            m_gapEnd = gapEnd;
+            m_endOfStorage = endOfStorage;
+        }
+
+        void destroy_and_deallocate() noexcept
+        {
+            destroy_range(m_buffer, m_gapBegin);
+            destroy_range(m_gapEnd, m_endOfStorage);
+            Allocator_traits::deallocate(m_allocator, m_buffer, capacity());
+        }
+
+        void destroy_range(pointer first, pointer last) noexcept
+        {
+            for (; first != last; ++first)
+            {
+                Allocator_traits::destroy(m_allocator, first);
+            }
+        }
+
+    private:
+        pointer m_buffer = nullptr;
+        pointer m_gapBegin = nullptr;
+        pointer m_gapEnd = nullptr;
+        pointer m_endOfStorage = nullptr;
+
+        Allocator m_allocator;
+    };
+
+} // namespace stl_container_impl
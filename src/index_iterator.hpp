@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace stl_container_impl
+{
+    // Index based random access iterator, dereferencing goes through the owner's operator[].
+    template <typename Owner, typename Value>
+    class index_iterator
+    {
+        template <typename O, typename V>
+        friend class index_iterator;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = Value&;
+        using pointer = Value*;
+
+        index_iterator() noexcept = default;
+
+        index_iterator(Owner* owner, difference_type pos) noexcept
+            : m_owner(owner)
+            , m_pos(pos)
+        {
+        }
+
+        template <typename O, typename V, typename = std::enable_if_t<std::is_convertible<O*, Owner*>::value>>
+        index_iterator(const index_iterator<O, V>& other) noexcept
+            : m_owner(other.m_owner)
+            , m_pos(other.m_pos)
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return (*m_owner)[m_pos];
+        }
+        pointer operator->() const noexcept
+        {
+            return std::addressof((*m_owner)[m_pos]);
+        }
+        reference operator[](difference_type n) const noexcept
+        {
+            return (*m_owner)[m_pos + n];
+        }
+
+        index_iterator& operator++() noexcept
+        {
+            ++m_pos;
+            return *this;
+        }
+        index_iterator operator++(int) noexcept
+        {
+            return index_iterator(m_owner, m_pos++);
+        }
+        index_iterator& operator--() noexcept
+        {
+            --m_pos;
+            return *this;
+        }
+        index_iterator operator--(int) noexcept
+        {
+            return index_iterator(m_owner, m_pos--);
+        }
+
+        index_iterator& operator+=(difference_type n) noexcept
+        {
+            m_pos += n;
+            return *this;
+        }
+        index_iterator operator+(difference_type n) const noexcept
+        {
+            return index_iterator(m_owner, m_pos + n);
+        }
+        index_iterator& operator-=(difference_type n) noexcept
+        {
+            m_pos -= n;
+            return *this;
+        }
+        index_iterator operator-(difference_type n) const noexcept
+        {
+            return index_iterator(m_owner, m_pos - n);
+        }
+        friend index_iterator operator+(difference_type n, const index_iterator& it) noexcept
+        {
+            return it + n;
+        }
+
+        // Mixed iterator/const_iterator operands are accepted in either order.
+        template <typename O, typename V>
+        difference_type operator-(const index_iterator<O, V>& other) const noexcept
+        {
+            return m_pos - other.m_pos;
+        }
+
+        template <typename O, typename V>
+        bool operator==(const index_iterator<O, V>& other) const noexcept
+        {
+            return m_pos == other.m_pos;
+        }
+        template <typename O, typename V>
+        bool operator!=(const index_iterator<O, V>& other) const noexcept
+        {
+            return m_pos != other.m_pos;
+        }
+        template <typename O, typename V>
+        bool operator<(const index_iterator<O, V>& other) const noexcept
+        {
+            return m_pos < other.m_pos;
+        }
+        template <typename O, typename V>
+        bool operator>(const index_iterator<O, V>& other) const noexcept
+        {
+            return m_pos > other.m_pos;
+        }
+        template <typename O, typename V>
+        bool operator<=(const index_iterator<O, V>& other) const noexcept
+        {
+            return m_pos <= other.m_pos;
+        }
+        template <typename O, typename V>
+        bool operator>=(const index_iterator<O, V>& other) const noexcept
+        {
+            return m_pos >= other.m_pos;
+        }
+
+        difference_type index() const noexcept
+        {
+            return m_pos;
+        }
+
+    private:
+        Owner* m_owner = nullptr;
+        difference_type m_pos = 0;
+    };
+
+} // namespace stl_container_impl
@@ -0,0 +1,341 @@
+#pragma once
+
+#include "span.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace stl_container_impl
+{
+    namespace detail
+    {
+        // True if It is a pointer_wrapper_iterator (Vector, String and Span iterators) over a
+        // pointer convertible to Pointer. Other iterators with a base(), like move_iterator or
+        // reverse_iterator, do not read the pointed-to range in order and are not included.
+        template <class It, class Pointer>
+        struct is_pointer_wrapper_iterator : std::false_type
+        {
+        };
+
+        template <class Iterator, class Container, class Pointer>
+        struct is_pointer_wrapper_iterator<pointer_wrapper_iterator<Iterator, Container>, Pointer>
+            : std::is_convertible<Iterator, Pointer>
+        {
+        };
+
+    } // namespace detail
+
+    /*---------------------------------------------------------------------------------------------
+     * Sequence of variable-length rows stored in compressed sparse row (CSR) layout:
+     * all elements live in one flat Vector<T> and row i spans [offsets[i], offsets[i + 1]).
+     * Compared to Vector<Vector<T>> it needs two allocations instead of one per row and keeps
+     * consecutive rows adjacent in memory.
+     *
+     * Rows are only appended at the back. For bulk construction use the two-pass build:
+     * count the row sizes, call assign_row_sizes() and then fill every row through row(i).
+     -----------------------------------------------------------------------------------------------*/
+    template <class T, class Allocator = std::allocator<T>>
+    class JaggedVector
+    {
+        using Allocator_traits = std::allocator_traits<Allocator>;
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using row_type = Span<T>;
+        using const_row_type = Span<const T>;
+
+    private:
+        using Offset_allocator = typename Allocator_traits::template rebind_alloc<size_type>;
+
+    public:
+        JaggedVector() = default;
+
+        // Reserves space for rowCount rows holding elementCount elements in total.
+        void reserve(size_type rowCount, size_type elementCount)
+        {
+            m_offsets.reserve(rowCount + 1);
+            m_values.reserve(elementCount);
+        }
+
+        // Forward ranges are appended with a single reservation. The source may be a row of this
+        // container (e.g. append_row(row(0))): pointer and Span ranges into the stored elements
+        // are read by offset, so a reallocation does not invalidate them.
+        template <typename InputIt>
+        void append_row(InputIt first, InputIt last)
+        {
+            if constexpr (std::is_convertible<InputIt, const T*>::value)
+            {
+                append_row_from_pointers(first, last);
+            }
+            else if constexpr (detail::is_pointer_wrapper_iterator<InputIt, const T*>::value)
+            {
+                append_row_from_pointers(first.base(), last.base());
+            }
+            else
+            {
+                if constexpr (std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>::value)
+                {
+                    reserve_values(static_cast<size_type>(std::distance(first, last)));
+                }
+
+                append_row_with([&] {
+                    for (; first != last; ++first)
+                    {
+                        m_values.emplace_back(*first);
+                    }
+                });
+            }
+        }
+
+        void append_row(std::initializer_list<T> ilist)
+        {
+            append_row(ilist.begin(), ilist.end());
+        }
+
+        void append_row(const_row_type row)
+        {
+            append_row_from_pointers(row.data(), row.data() + row.size());
+        }
+
+        /*---------------------------------------------------------------------------------------------
+         * First pass of the two-pass build. Replaces the contents with one row per element of
+         * [countsFirst, countsLast), row i having *(countsFirst + i) default constructed elements.
+         * Offsets and elements are each allocated once.
+         -----------------------------------------------------------------------------------------------*/
+        template <typename ForwardIt>
+        void assign_row_sizes(ForwardIt countsFirst, ForwardIt countsLast)
+        {
+            clear();
+            m_offsets.reserve(static_cast<size_type>(std::distance(countsFirst, countsLast)) + 1);
+
+            size_type total = 0;
+            m_offsets.push_back(total);
+            for (; countsFirst != countsLast; ++countsFirst)
+            {
+                total += static_cast<size_type>(*countsFirst);
+                m_offsets.push_back(total);
+            }
+
+            m_values.resize(total);
+        }
+
+        void pop_row() noexcept
+        {
+            m_offsets.pop_back();
+            while (m_values.size() != m_offsets.back())
+            {
+                m_values.pop_back();
+            }
+
+            if (m_offsets.size() == 1)
+            {
+                m_offsets.clear();
+            }
+        }
+
+        void clear() noexcept
+        {
+            m_values.clear();
+            m_offsets.clear();
+        }
+
+        /*---------------------------------------------------------------------------------------------
+         * Calls fn(rowIndex, row) for every row in [firstRow, lastRow).
+         * Rows are disjoint, so different threads may process disjoint row ranges concurrently.
+         -----------------------------------------------------------------------------------------------*/
+        template <typename Fn>
+        void for_each_row(size_type firstRow, size_type lastRow, Fn fn)
+        {
+            const auto offsets = m_offsets.data();
+            const auto values = m_values.data();
+            for (; firstRow < lastRow; ++firstRow)
+            {
+                fn(firstRow, row_type{ values + offsets[firstRow], offsets[firstRow + 1] - offsets[firstRow] });
+            }
+        }
+
+        template <typename Fn>
+        void for_each_row(size_type firstRow, size_type lastRow, Fn fn) const
+        {
+            const auto offsets = m_offsets.data();
+            const auto values = m_values.data();
+            for (; firstRow < lastRow; ++firstRow)
+            {
+                fn(firstRow, const_row_type{ values + offsets[firstRow], offsets[firstRow + 1] - offsets[firstRow] });
+            }
+        }
+
+    public:
+        row_type row(size_type pos) noexcept
+        {
+            const auto offsets = m_offsets.data();
+            return row_type{ m_values.data() + offsets[pos], offsets[pos + 1] - offsets[pos] };
+        }
+
+        const_row_type row(size_type pos) const noexcept
+        {
+            const auto offsets = m_offsets.data();
+            return const_row_type{ m_values.data() + offsets[pos], offsets[pos + 1] - offsets[pos] };
+        }
+
+        row_type operator[](size_type pos) noexcept
+        {
+            return row(pos);
+        }
+
+        const_row_type operator[](size_type pos) const noexcept
+        {
+            return row(pos);
+        }
+
+        row_type at(size_type pos)
+        {
+            if (pos >= row_count())
+            {
+                throw std::out_of_range("JaggedVector::at");
+            }
+
+            return row(pos);
+        }
+
+        const_row_type at(size_type pos) const
+        {
+            if (pos >= row_count())
+            {
+                throw std::out_of_range("JaggedVector::at");
+            }
+
+            return row(pos);
+        }
+
+        size_type row_size(size_type pos) const noexcept
+        {
+            const auto offsets = m_offsets.data();
+            return offsets[pos + 1] - offsets[pos];
+        }
+
+        bool empty() const noexcept
+        {
+            return row_count() == 0;
+        }
+
+        size_type row_count() const noexcept
+        {
+            return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+        }
+
+        // Total number of elements over all rows.
+        size_type size() const noexcept
+        {
+            return m_values.size();
+        }
+
+        // Flat element storage, rows are stored back to back.
+        Span<T> values() noexcept
+        {
+            return Span<T>{ m_values.data(), m_values.size() };
+        }
+
+        Span<const T> values() const noexcept
+        {
+            return Span<const T>{ m_values.data(), m_values.size() };
+        }
+
+        // row_count() + 1 offsets into values(); empty or { 0 } if there are no rows.
+        Span<const size_type> offsets() const noexcept
+        {
+            return Span<const size_type>{ m_offsets.data(), m_offsets.size() };
+        }
+
+        Allocator get_allocator() const noexcept
+        {
+            return m_values.get_allocator();
+        }
+
+    private:
+        void ensure_offsets()
+        {
+            if (m_offsets.empty())
+            {
+                m_offsets.push_back(0);
+            }
+        }
+
+        // Makes room for count more elements, growing geometrically so that appending many rows
+        // stays amortized O(1) per element.
+        void reserve_values(size_type count)
+        {
+            const auto required = m_values.size() + count;
+            if (required > m_values.capacity())
+            {
+                m_values.reserve(std::max(required, 2 * m_values.capacity()));
+            }
+        }
+
+        void append_row_from_pointers(const T* first, const T* last)
+        {
+            const auto count = static_cast<size_type>(last - first);
+            const T* values = m_values.data();
+            const std::less<const T*> before;
+
+            if (count != 0 && !before(first, values) && before(first, values + m_values.size()))
+            {
+                // The source is part of m_values, which reserve_values() may reallocate
+                const auto offset = static_cast<size_type>(first - values);
+                reserve_values(count);
+                append_row_with([&] {
+                    for (size_type i = 0; i != count; ++i)
+                    {
+                        m_values.emplace_back(m_values.data()[offset + i]);
+                    }
+                });
+                return;
+            }
+
+            reserve_values(count);
+            append_row_with([&] {
+                for (; first != last; ++first)
+                {
+                    m_values.emplace_back(*first);
+                }
+            });
+        }
+
+        // Runs appendValues, which emplaces the new row's elements, and commits them as a row.
+        // If it throws, the elements appended so far are removed.
+        template <typename Fn>
+        void append_row_with(Fn appendValues)
+        {
+            ensure_offsets();
+
+            const auto oldSize = m_values.size();
+            try
+            {
+                appendValues();
+                m_offsets.push_back(m_values.size());
+            }
+            catch (...)
+            {
+                while (m_values.size() != oldSize)
+                {
+                    m_values.pop_back();
+                }
+                throw;
+            }
+        }
+
+    private:
+        Vector<T, Allocator> m_values;
+        Vector<size_type, Offset_allocator> m_offsets;
+    };
+
+} // namespace stl_container_impl
@@ -1,5 +1,6 @@
 #include "vector.hpp"
 
+#include <array>
 #include <vector>
 #include <iostream>
 
@@ -69,6 +70,22 @@ struct Point
     int id;
 };
 
+#if STL_CONTAINER_IMPL_HAS_CONSTEXPR_ALLOC
+// Lookup table computed at compile time through Vector
+constexpr std::array<int, 8> make_squares()
+{
+    stl_container_impl::Vector<int> v;
+    for (int i = 0; i < 8; ++i)
+        v.push_back(i * i);
+
+    std::array<int, 8> table{};
+    std::copy(v.cbegin(), v.cend(), table.begin());
+    return table;
+}
+
+static_assert(make_squares()[7] == 49);
+#endif
+
 int main()
 {
     stl_container_impl::Vector<Point> v;
@@ -0,0 +1,292 @@
+#pragma once
+
+#include "bit_ops.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace stl_container_impl
+{
+    namespace detail
+    {
+        template <unsigned Width>
+        constexpr std::uint64_t low_bits_mask() noexcept
+        {
+            if constexpr (Width == 64)
+                return ~std::uint64_t(0);
+            else
+                return (std::uint64_t(1) << Width) - 1;
+        }
+
+        // Blocks are packed as packed_lanes interleaved bit streams (see PackedIntVector), so one
+        // step decodes packed_lanes adjacent values from adjacent words with the same shift.
+        // Width is a compile-time constant and the step is branch-free, which lets the compiler
+        // turn it into vector shifts.
+        inline constexpr std::size_t packed_lanes = 4;
+
+        template <std::size_t BlockSize, unsigned Width>
+        void unpack_block(const std::uint64_t* words, std::uint64_t base, std::uint64_t* out) noexcept
+        {
+            if constexpr (Width == 0)
+            {
+                for (std::size_t j = 0; j != BlockSize; ++j)
+                {
+                    out[j] = base;
+                }
+            }
+            else
+            {
+                for (std::size_t step = 0; step != BlockSize / packed_lanes; ++step)
+                {
+                    const auto bit = step * Width;
+                    const auto shift = bit % 64;
+                    const auto row = words + bit / 64 * packed_lanes;
+                    // Row holding the high bits of values that straddle a word boundary.
+                    // Otherwise the same row, whose bits then land above Width and are masked off.
+                    const auto next = shift + Width > 64 ? row + packed_lanes : row;
+
+                    // Load before storing: out may alias words as far as the compiler knows
+                    std::uint64_t low[packed_lanes];
+                    std::uint64_t high[packed_lanes];
+                    for (std::size_t lane = 0; lane != packed_lanes; ++lane)
+                    {
+                        low[lane] = row[lane];
+                        high[lane] = next[lane];
+                    }
+
+                    for (std::size_t lane = 0; lane != packed_lanes; ++lane)
+                    {
+                        const auto value = (low[lane] >> shift) | ((high[lane] << 1) << (63 - shift));
+                        out[step * packed_lanes + lane] = base + (value & low_bits_mask<Width>());
+                    }
+                }
+            }
+        }
+
+        using unpack_block_fn = void (*)(const std::uint64_t*, std::uint64_t, std::uint64_t*) noexcept;
+
+        template <std::size_t BlockSize, std::size_t... Widths>
+        constexpr std::array<unpack_block_fn, sizeof...(Widths)> make_unpack_table(std::index_sequence<Widths...>) noexcept
+        {
+            return { &unpack_block<BlockSize, static_cast<unsigned>(Widths)>... };
+        }
+
+    } // namespace detail
+
+    /*---------------------------------------------------------------------------------------------
+     * Vector of 64-bit unsigned integers compressed with frame-of-reference bit packing.
+     *
+     * Values are grouped into blocks of BlockSize elements. A full block is stored as its minimum
+     * (the frame of reference) plus every value's offset from it, packed with the smallest
+     * bit width that fits the block's range. The last, incomplete block is kept uncompressed
+     * and is packed once it fills up, which makes push_back amortized O(1).
+     * Random access is O(1): the block header gives the word offset and bit width directly.
+     *
+     * Inside a block, value j goes to the bit stream of lane j % 4, and the lanes' words are
+     * interleaved (word i of lane l is at 4 * i + l). Decoding then works on 4 values at a time
+     * with whole-vector loads and shifts. BlockSize / 4 is a multiple of 64, so every lane ends
+     * on a word boundary and the layout costs no padding.
+     -----------------------------------------------------------------------------------------------*/
+    template <std::size_t BlockSize = 256, class Allocator = std::allocator<std::uint64_t>>
+    class PackedIntVector
+    {
+        static_assert(BlockSize != 0 && BlockSize % (64 * detail::packed_lanes) == 0, "BlockSize must be a non-zero multiple of 256");
+
+        struct BlockHeader
+        {
+            std::uint64_t base;
+            std::size_t wordOffset;
+            unsigned width;
+        };
+
+        using Allocator_traits = std::allocator_traits<Allocator>;
+        using Header_allocator = typename Allocator_traits::template rebind_alloc<BlockHeader>;
+
+    public:
+        using value_type = std::uint64_t;
+        using size_type = std::size_t;
+        using allocator_type = Allocator;
+
+        static constexpr size_type block_size = BlockSize;
+
+    public:
+        PackedIntVector() = default;
+
+        void push_back(value_type value)
+        {
+            if (m_tail.capacity() < BlockSize)
+            {
+                m_tail.reserve(BlockSize);
+            }
+
+            m_tail.push_back(value);
+            ++m_size;
+
+            if (m_tail.size() >= BlockSize)
+            {
+                seal_tail();
+            }
+        }
+
+        void clear() noexcept
+        {
+            m_words.clear();
+            m_headers.clear();
+            m_tail.clear();
+            m_size = 0;
+        }
+
+        value_type operator[](size_type pos) const noexcept
+        {
+            const auto block = pos / BlockSize;
+            const auto index = pos % BlockSize;
+
+            if (block >= m_headers.size())
+            {
+                return m_tail.data()[pos - m_headers.size() * BlockSize];
+            }
+
+            const auto& header = m_headers.data()[block];
+            if (header.width == 0)
+            {
+                return header.base;
+            }
+
+            const auto lane = index % detail::packed_lanes;
+            const auto words = m_words.data() + header.wordOffset + lane;
+            const auto bit = index / detail::packed_lanes * header.width;
+            const auto wordIndex = bit / 64 * detail::packed_lanes;
+            const auto shift = bit % 64;
+
+            auto value = words[wordIndex] >> shift;
+            if (shift + header.width > 64)
+            {
+                value |= words[wordIndex + detail::packed_lanes] << (64 - shift);
+            }
+
+            const auto mask = header.width == 64 ? ~value_type(0) : (value_type(1) << header.width) - 1;
+            return header.base + (value & mask);
+        }
+
+        value_type at(size_type pos) const
+        {
+            if (pos >= m_size)
+            {
+                throw std::out_of_range("PackedIntVector::at");
+            }
+
+            return (*this)[pos];
+        }
+
+        // Replaces the contents of out with all stored values, decoding a whole block at a time.
+        template <typename OutAllocator>
+        void decode(Vector<value_type, OutAllocator>& out) const
+        {
+            out.resize(m_size);
+            auto dst = out.data();
+
+            const auto headers = m_headers.data();
+            const auto blockCount = m_headers.size();
+            for (size_type block = 0; block != blockCount; ++block, dst += BlockSize)
+            {
+                const auto& header = headers[block];
+                s_unpackTable[header.width](m_words.data() + header.wordOffset, header.base, dst);
+            }
+
+            std::copy(m_tail.data(), m_tail.data() + m_tail.size(), dst);
+        }
+
+    public:
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        void shrink_to_fit()
+        {
+            m_words.shrink_to_fit();
+            m_headers.shrink_to_fit();
+        }
+
+        // Bytes occupied by the stored data: packed words, block headers and the uncompressed tail.
+        size_type memory_usage() const noexcept
+        {
+            return m_words.capacity() * sizeof(value_type) + m_headers.capacity() * sizeof(BlockHeader) + m_tail.capacity() * sizeof(value_type);
+        }
+
+        Allocator get_allocator() const noexcept
+        {
+            return m_words.get_allocator();
+        }
+
+    private:
+        void seal_tail()
+        {
+            const auto values = m_tail.data();
+            const auto [minIt, maxIt] = std::minmax_element(values, values + BlockSize);
+            const auto base = *minIt;
+            const auto width = detail::bit_width64(*maxIt - base);
+
+            const BlockHeader header{ base, m_words.size(), width };
+            const auto wordCount = BlockSize * width / 64;
+
+            const auto newWordCount = m_words.size() + wordCount;
+            if (newWordCount > m_words.capacity())
+            {
+                // Vector::resize allocates exactly what is asked for, grow geometrically instead
+                m_words.reserve(std::max(newWordCount, 2 * m_words.capacity()));
+            }
+
+            m_words.resize(newWordCount); // zero-filled, bits are OR-ed in below
+            try
+            {
+                m_headers.push_back(header);
+            }
+            catch (...)
+            {
+                m_words.resize(header.wordOffset);
+                throw;
+            }
+
+            const auto words = m_words.data() + header.wordOffset;
+            for (size_type j = 0; width != 0 && j != BlockSize; ++j)
+            {
+                const auto value = values[j] - base;
+                const auto lane = j % detail::packed_lanes;
+                const auto bit = j / detail::packed_lanes * width;
+                const auto wordIndex = bit / 64 * detail::packed_lanes + lane;
+                const auto shift = bit % 64;
+
+                words[wordIndex] |= value << shift;
+                if (shift + width > 64)
+                {
+                    words[wordIndex + detail::packed_lanes] |= value >> (64 - shift);
+                }
+            }
+
+            // More than BlockSize values are only left after a previous seal_tail() threw
+            const auto rest = m_tail.size() - BlockSize;
+            std::copy(values + BlockSize, values + BlockSize + rest, values);
+            m_tail.resize(rest);
+        }
+
+    private:
+        static constexpr auto s_unpackTable = detail::make_unpack_table<BlockSize>(std::make_index_sequence<65>{});
+
+        Vector<value_type, Allocator> m_words;
+        Vector<BlockHeader, Header_allocator> m_headers;
+        Vector<value_type, Allocator> m_tail;
+        size_type m_size = 0;
+    };
+
+} // namespace stl_container_impl
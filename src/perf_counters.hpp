@@ -0,0 +1,429 @@
+#pragma once
+
+#include "bit_ops.hpp"
+#include "config.hpp"
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <ostream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*---------------------------------------------------------------------------------------------
+ * Hardware performance counter instrumentation for container operations.
+ *
+ * Vector wraps its expensive operations in a perf::Scope when built with
+ * STL_CONTAINER_IMPL_PERF_COUNTERS=1 (CMake option of the same name); otherwise the scopes compile
+ * to nothing. In an instrumented build, recording is switched on by setting the environment
+ * variable STL_CONTAINER_IMPL_PERF to anything but "0", or by calling perf::set_enabled(true).
+ *
+ * Each scope reads the calling thread's counters (perf_event_open on Linux) on entry and exit and
+ * adds the difference to a per-operation log2 histogram. Scopes are inclusive: reserve() called
+ * from another instrumented operation is counted by both. When the counters cannot be opened,
+ * e.g. in containers with a restrictive perf_event_paranoid or seccomp profile, only call counts
+ * and wall-clock time are recorded.
+ *
+ * The report is printed by perf::report() and, if anything was recorded, to std::cerr at exit.
+ * An instrumented bench target records unless STL_CONTAINER_IMPL_PERF is "0" and prints the
+ * report after each benchmark.
+ -----------------------------------------------------------------------------------------------*/
+
+namespace stl_container_impl
+{
+    namespace perf
+    {
+        enum class Operation : std::size_t
+        {
+            Reserve,
+            Resize,
+            Insert,
+            Erase,
+            ShrinkToFit,
+            Reallocate, // growth on emplace_back/push_back
+            Count
+        };
+
+        enum class Counter : std::size_t
+        {
+            Cycles,
+            Instructions,
+            BranchMisses,
+            L1dMisses,
+            LlcMisses,
+            DtlbMisses,
+            Nanoseconds, // wall clock, always available
+            Count
+        };
+
+        inline constexpr std::size_t operation_count = static_cast<std::size_t>(Operation::Count);
+        inline constexpr std::size_t counter_count = static_cast<std::size_t>(Counter::Count);
+        inline constexpr std::size_t hardware_counter_count = static_cast<std::size_t>(Counter::Nanoseconds);
+
+        inline const char* operation_name(Operation operation) noexcept
+        {
+            static constexpr const char* names[] = { "reserve", "resize", "insert", "erase", "shrink_to_fit", "reallocate" };
+            return names[static_cast<std::size_t>(operation)];
+        }
+
+        inline const char* counter_name(Counter counter) noexcept
+        {
+            static constexpr const char* names[] = { "cycles", "instructions", "branch misses", "L1d misses", "LLC misses", "dTLB misses", "ns" };
+            return names[static_cast<std::size_t>(counter)];
+        }
+
+        using Sample = std::array<std::uint64_t, counter_count>;
+
+        namespace detail
+        {
+            /*---------------------------------------------------------------------------------------------
+             * Counters of the calling thread, opened as one perf event group on first use so that all
+             * of them are read with a single read(). Events the kernel or PMU does not support are
+             * left out; if the group leader (cycles) cannot be opened nothing is.
+             -----------------------------------------------------------------------------------------------*/
+            class CounterGroup
+            {
+            public:
+                CounterGroup() noexcept
+                {
+#if defined(__linux__)
+                    static constexpr std::uint32_t types[hardware_counter_count] = {
+                        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE
+                    };
+                    static constexpr std::uint64_t configs[hardware_counter_count] = {
+                        PERF_COUNT_HW_CPU_CYCLES,
+                        PERF_COUNT_HW_INSTRUCTIONS,
+                        PERF_COUNT_HW_BRANCH_MISSES,
+                        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                        PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                        PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+                    };
+
+                    for (std::size_t counter = 0; counter != hardware_counter_count; ++counter)
+                    {
+                        perf_event_attr attr;
+                        std::memset(&attr, 0, sizeof(attr));
+                        attr.size = sizeof(attr);
+                        attr.type = types[counter];
+                        attr.config = configs[counter];
+                        attr.read_format = PERF_FORMAT_GROUP;
+                        attr.disabled = m_leader == -1 ? 1 : 0;
+                        attr.exclude_kernel = 1;
+                        attr.exclude_hv = 1;
+
+                        const int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, m_leader, 0));
+                        if (fd == -1)
+                        {
+                            if (m_leader == -1)
+                            {
+                                m_error = errno;
+                                break;
+                            }
+                            continue;
+                        }
+
+                        if (m_leader == -1)
+                            m_leader = fd;
+                        else
+                            m_members[m_memberCount - 1] = fd;
+
+                        m_slots[m_memberCount++] = counter;
+                    }
+
+                    if (m_leader != -1)
+                        ::ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+                    m_error = ENOSYS;
+#endif
+                }
+
+                CounterGroup(const CounterGroup&) = delete;
+                CounterGroup& operator=(const CounterGroup&) = delete;
+
+                ~CounterGroup()
+                {
+#if defined(__linux__)
+                    for (std::size_t i = 0; i + 1 < m_memberCount; ++i)
+                    {
+                        ::close(m_members[i]);
+                    }
+
+                    if (m_leader != -1)
+                        ::close(m_leader);
+#endif
+                }
+
+                bool available() const noexcept
+                {
+                    return m_memberCount != 0;
+                }
+
+                // Bit mask of the Counters this group provides.
+                unsigned mask() const noexcept
+                {
+                    unsigned result = 1u << static_cast<unsigned>(Counter::Nanoseconds);
+                    for (std::size_t i = 0; i != m_memberCount; ++i)
+                    {
+                        result |= 1u << m_slots[i];
+                    }
+                    return result;
+                }
+
+                int error() const noexcept
+                {
+                    return m_error;
+                }
+
+                void read(Sample& sample) const noexcept
+                {
+#if defined(__linux__)
+                    if (available())
+                    {
+                        // PERF_FORMAT_GROUP layout: { nr, value[nr] }
+                        std::uint64_t buffer[1 + hardware_counter_count];
+                        const auto bytes = static_cast<std::size_t>(1 + m_memberCount) * sizeof(std::uint64_t);
+                        if (::read(m_leader, buffer, bytes) == static_cast<ssize_t>(bytes))
+                        {
+                            for (std::size_t i = 0; i != m_memberCount; ++i)
+                            {
+                                sample[m_slots[i]] = buffer[1 + i];
+                            }
+                        }
+                    }
+#endif
+                    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+                    sample[static_cast<std::size_t>(Counter::Nanoseconds)] =
+                        static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+                }
+
+            private:
+                int m_leader = -1;
+                int m_members[hardware_counter_count - 1] = {};
+                std::size_t m_slots[hardware_counter_count] = {}; // read order -> Counter
+                std::size_t m_memberCount = 0;
+                int m_error = 0;
+            };
+
+            inline CounterGroup& thread_counters() noexcept
+            {
+                thread_local CounterGroup group;
+                return group;
+            }
+
+            // Histogram bucket i counts deltas in [2^(i-1), 2^i); bucket 0 counts zero deltas.
+            struct Histogram
+            {
+                std::atomic<std::uint64_t> buckets[65] = {};
+                std::atomic<std::uint64_t> total{ 0 };
+
+                void add(std::uint64_t value) noexcept
+                {
+                    const auto bucket = value == 0 ? 0 : stl_container_impl::detail::bit_width64(value);
+                    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+                    total.fetch_add(value, std::memory_order_relaxed);
+                }
+            };
+
+            struct OperationStats
+            {
+                std::atomic<std::uint64_t> calls{ 0 };
+                Histogram counters[counter_count];
+            };
+
+            class Registry
+            {
+            public:
+                Registry() noexcept
+                {
+                    const char* env = std::getenv("STL_CONTAINER_IMPL_PERF");
+                    m_enabled.store(env != nullptr && *env != '\0' && std::strcmp(env, "0") != 0, std::memory_order_relaxed);
+                }
+
+                Registry(const Registry&) = delete;
+                Registry& operator=(const Registry&) = delete;
+
+                ~Registry()
+                {
+                    if (m_recorded.load(std::memory_order_relaxed))
+                        report(std::cerr);
+                }
+
+                static Registry& instance() noexcept
+                {
+                    static Registry registry;
+                    return registry;
+                }
+
+                bool enabled() const noexcept
+                {
+                    return m_enabled.load(std::memory_order_relaxed);
+                }
+
+                void set_enabled(bool enabled) noexcept
+                {
+                    m_enabled.store(enabled, std::memory_order_relaxed);
+                }
+
+                void record(Operation operation, const Sample& begin, const Sample& end, const CounterGroup& counters) noexcept
+                {
+                    const auto mask = counters.mask();
+                    if (!counters.available())
+                        m_error.store(counters.error(), std::memory_order_relaxed);
+
+                    auto& stats = m_stats[static_cast<std::size_t>(operation)];
+                    stats.calls.fetch_add(1, std::memory_order_relaxed);
+
+                    for (std::size_t counter = 0; counter != counter_count; ++counter)
+                    {
+                        if (mask & (1u << counter))
+                            stats.counters[counter].add(end[counter] - begin[counter]);
+                    }
+
+                    m_mask.fetch_or(mask, std::memory_order_relaxed);
+                    m_recorded.store(true, std::memory_order_relaxed);
+                }
+
+                void reset() noexcept
+                {
+                    for (auto& stats : m_stats)
+                    {
+                        stats.calls.store(0, std::memory_order_relaxed);
+                        for (auto& histogram : stats.counters)
+                        {
+                            histogram.total.store(0, std::memory_order_relaxed);
+                            for (auto& bucket : histogram.buckets)
+                            {
+                                bucket.store(0, std::memory_order_relaxed);
+                            }
+                        }
+                    }
+
+                    m_recorded.store(false, std::memory_order_relaxed);
+                }
+
+                void report(std::ostream& out) const
+                {
+                    // Not thread_counters(): this also runs at exit, after thread_local destruction.
+                    const auto mask = m_mask.load(std::memory_order_relaxed);
+                    const auto error = m_error.load(std::memory_order_relaxed);
+                    if (error != 0)
+                    {
+                        out << "perf: hardware counters unavailable (" << std::strerror(error) << "), reporting wall clock only\n";
+                    }
+
+                    for (std::size_t operation = 0; operation != operation_count; ++operation)
+                    {
+                        const auto& stats = m_stats[operation];
+                        const auto calls = stats.calls.load(std::memory_order_relaxed);
+                        if (calls == 0)
+                            continue;
+
+                        out << "perf: Vector::" << operation_name(static_cast<Operation>(operation)) << ", " << calls << " calls\n";
+                        for (std::size_t counter = 0; counter != counter_count; ++counter)
+                        {
+                            if (!(mask & (1u << counter)))
+                                continue;
+
+                            const auto& histogram = stats.counters[counter];
+                            out << "  " << counter_name(static_cast<Counter>(counter))
+                                << ": mean " << histogram.total.load(std::memory_order_relaxed) / calls << "\n";
+
+                            for (std::size_t bucket = 0; bucket != 65; ++bucket)
+                            {
+                                const auto count = histogram.buckets[bucket].load(std::memory_order_relaxed);
+                                if (count == 0)
+                                    continue;
+
+                                const auto low = bucket == 0 ? std::uint64_t(0) : std::uint64_t(1) << (bucket - 1);
+                                out << "    >= " << low << ": " << count << "\n";
+                            }
+                        }
+                    }
+                }
+
+            private:
+                std::atomic<bool> m_enabled{ false };
+                std::atomic<bool> m_recorded{ false };
+                std::atomic<unsigned> m_mask{ 0 };
+                std::atomic<int> m_error{ 0 };
+                OperationStats m_stats[operation_count];
+            };
+
+        } // namespace detail
+
+        inline void set_enabled(bool enabled) noexcept
+        {
+            detail::Registry::instance().set_enabled(enabled);
+        }
+
+        inline void reset() noexcept
+        {
+            detail::Registry::instance().reset();
+        }
+
+        inline void report(std::ostream& out)
+        {
+            detail::Registry::instance().report(out);
+        }
+
+        /*---------------------------------------------------------------------------------------------
+         * Measures the enclosing block as one call of operation. Does nothing in constant evaluation,
+         * so instrumented functions stay constexpr.
+         -----------------------------------------------------------------------------------------------*/
+        class Scope
+        {
+        public:
+            STL_CONTAINER_IMPL_CONSTEXPR20 explicit Scope(Operation operation) noexcept
+                : m_operation(operation)
+            {
+                if (!stl_container_impl::detail::is_constant_evaluated())
+                    start();
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+            STL_CONTAINER_IMPL_CONSTEXPR20 ~Scope()
+            {
+                if (m_active)
+                    stop();
+            }
+
+        private:
+            void start() noexcept
+            {
+                if (!detail::Registry::instance().enabled())
+                    return;
+
+                m_active = true;
+                detail::thread_counters().read(m_begin);
+            }
+
+            void stop() noexcept
+            {
+                auto& counters = detail::thread_counters();
+
+                Sample end{};
+                counters.read(end);
+                detail::Registry::instance().record(m_operation, m_begin, end, counters);
+            }
+
+        private:
+            Operation m_operation;
+            bool m_active = false;
+            Sample m_begin{};
+        };
+
+    } // namespace perf
+
+} // namespace stl_container_impl
@@ -0,0 +1,392 @@
+#pragma once
+
+#include "vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace stl_container_impl
+{
+    namespace detail
+    {
+        template <class T, class SizeType, bool TrackHandles>
+        struct heap_entry
+        {
+            using type = T;
+        };
+
+        template <class T, class SizeType>
+        struct heap_entry<T, SizeType, true>
+        {
+            struct type
+            {
+                T value;
+                SizeType handle;
+            };
+        };
+
+    } // namespace detail
+
+    /*---------------------------------------------------------------------------------------------
+     * Priority queue adaptor over Vector backed by an implicit D-ary heap.
+     *
+     * Compare works as for std::priority_queue: top() is the element that is not ordered before
+     * any other, i.e. the largest one for std::less. A 4-ary heap is half as deep as a binary
+     * one and the children of a node share a cache line, so pops touch fewer lines.
+     *
+     * With TrackHandles every push() returns a handle that stays valid until the element is
+     * popped; update() and decrease_key() use it to reposition an element in O(log n).
+     -----------------------------------------------------------------------------------------------*/
+    template <class T, class Compare = std::less<T>, std::size_t D = 4, bool TrackHandles = false, class Allocator = std::allocator<T>>
+    class PriorityQueue
+    {
+        static_assert(D >= 2, "PriorityQueue arity must be at least 2");
+
+        using Allocator_traits = std::allocator_traits<Allocator>;
+
+    public:
+        using value_type = T;
+        using value_compare = Compare;
+        using size_type = std::size_t;
+        using const_reference = const T&;
+        using handle_type = size_type;
+
+        static constexpr size_type arity = D;
+        static constexpr handle_type invalid_handle = std::numeric_limits<handle_type>::max();
+
+    private:
+        using Entry = typename detail::heap_entry<T, size_type, TrackHandles>::type;
+        using Entry_allocator = typename Allocator_traits::template rebind_alloc<Entry>;
+        using Size_allocator = typename Allocator_traits::template rebind_alloc<size_type>;
+
+        // Handle bookkeeping, replaced by an empty placeholder without TrackHandles.
+        struct HandleTable
+        {
+            Vector<size_type, Size_allocator> positions; // handle -> heap index or invalid_handle
+            Vector<handle_type, Size_allocator> freeHandles;
+        };
+        struct NoHandleTable
+        {
+        };
+
+    public:
+        PriorityQueue() = default;
+
+        explicit PriorityQueue(const Compare& compare)
+            : m_compare(compare)
+        {
+        }
+
+        const_reference top() const
+        {
+            return value_of(m_heap.front());
+        }
+
+        bool empty() const noexcept
+        {
+            return m_heap.empty();
+        }
+
+        size_type size() const noexcept
+        {
+            return m_heap.size();
+        }
+
+        void reserve(size_type count)
+        {
+            m_heap.reserve(count);
+        }
+
+        // Returns the new element's handle, or invalid_handle without TrackHandles.
+        template <typename... Args>
+        handle_type emplace(Args&&... args)
+        {
+            const auto handle = append(std::forward<Args>(args)...);
+            sift_up(m_heap.size() - 1);
+
+            return handle;
+        }
+
+        handle_type push(const T& value)
+        {
+            return emplace(value);
+        }
+
+        handle_type push(T&& value)
+        {
+            return emplace(std::move(value));
+        }
+
+        /*---------------------------------------------------------------------------------------------
+         * Inserts [first, last). When the batch is at least as large as the current heap it is
+         * appended as is and the whole heap is rebuilt bottom-up in O(n), otherwise elements
+         * are sifted up one by one. If constructing an element throws, the elements appended so
+         * far stay in the queue and the heap order is restored before rethrowing.
+         -----------------------------------------------------------------------------------------------*/
+        template <typename InputIt>
+        void push_range(InputIt first, InputIt last)
+        {
+            const auto oldSize = m_heap.size();
+            if constexpr (std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>::value)
+            {
+                m_heap.reserve(oldSize + static_cast<size_type>(std::distance(first, last)));
+            }
+
+            try
+            {
+                for (; first != last; ++first)
+                {
+                    append(*first);
+                }
+            }
+            catch (...)
+            {
+                restore_heap(oldSize);
+                throw;
+            }
+
+            restore_heap(oldSize);
+        }
+
+        void pop()
+        {
+            release_handle(m_heap.front());
+
+            if (m_heap.size() > 1)
+            {
+                place(0, std::move(m_heap.back()));
+                m_heap.pop_back();
+                sift_down(0);
+            }
+            else
+            {
+                m_heap.pop_back();
+            }
+        }
+
+        // Equivalent to pop() followed by push(value) but with a single sift down.
+        // Returns the new element's handle, which reuses the popped element's one.
+        handle_type pop_push(T value)
+        {
+            auto& root = m_heap.front();
+            value_of(root) = std::move(value);
+
+            handle_type handle = invalid_handle;
+            if constexpr (TrackHandles)
+            {
+                handle = root.handle;
+            }
+
+            sift_down(0);
+            return handle;
+        }
+
+        // Replaces the value of the element identified by handle and restores the heap order.
+        template <bool Enabled = TrackHandles, typename = std::enable_if_t<Enabled>>
+        void update(handle_type handle, T value)
+        {
+            const auto pos = m_handles.positions.data()[handle];
+            auto& entry = m_heap.data()[pos];
+            const bool towardsTop = m_compare(entry.value, value);
+
+            entry.value = std::move(value);
+            if (towardsTop)
+                sift_up(pos);
+            else
+                sift_down(pos);
+        }
+
+        // update() for a value that is not ordered after the current one (moves towards the top only).
+        template <bool Enabled = TrackHandles, typename = std::enable_if_t<Enabled>>
+        void decrease_key(handle_type handle, T value)
+        {
+            const auto pos = m_handles.positions.data()[handle];
+            m_heap.data()[pos].value = std::move(value);
+            sift_up(pos);
+        }
+
+        template <bool Enabled = TrackHandles, typename = std::enable_if_t<Enabled>>
+        bool contains(handle_type handle) const noexcept
+        {
+            return handle < m_handles.positions.size() && m_handles.positions.data()[handle] != invalid_handle;
+        }
+
+        template <bool Enabled = TrackHandles, typename = std::enable_if_t<Enabled>>
+        const_reference value(handle_type handle) const
+        {
+            return m_heap.data()[m_handles.positions.data()[handle]].value;
+        }
+
+        void clear() noexcept
+        {
+            m_heap.clear();
+            if constexpr (TrackHandles)
+            {
+                m_handles.positions.clear();
+                m_handles.freeHandles.clear();
+            }
+        }
+
+    private:
+        static T& value_of(Entry& entry) noexcept
+        {
+            if constexpr (TrackHandles)
+                return entry.value;
+            else
+                return entry;
+        }
+
+        static const T& value_of(const Entry& entry) noexcept
+        {
+            if constexpr (TrackHandles)
+                return entry.value;
+            else
+                return entry;
+        }
+
+        template <typename... Args>
+        handle_type append(Args&&... args)
+        {
+            if constexpr (TrackHandles)
+            {
+                handle_type handle;
+                if (m_handles.freeHandles.empty())
+                {
+                    handle = m_handles.positions.size();
+                    m_handles.positions.push_back(invalid_handle);
+                }
+                else
+                {
+                    handle = m_handles.freeHandles.back();
+                    m_handles.freeHandles.pop_back();
+                }
+
+                try
+                {
+                    m_heap.emplace_back(Entry{ T(std::forward<Args>(args)...), handle });
+                }
+                catch (...)
+                {
+                    m_handles.freeHandles.push_back(handle);
+                    throw;
+                }
+
+                m_handles.positions.data()[handle] = m_heap.size() - 1;
+                return handle;
+            }
+            else
+            {
+                m_heap.emplace_back(std::forward<Args>(args)...);
+                return invalid_handle;
+            }
+        }
+
+        void release_handle(const Entry& entry)
+        {
+            if constexpr (TrackHandles)
+            {
+                m_handles.positions.data()[entry.handle] = invalid_handle;
+                m_handles.freeHandles.push_back(entry.handle);
+            }
+        }
+
+        // Moves entry into heap slot pos, keeping the handle table in sync.
+        void place(size_type pos, Entry&& entry)
+        {
+            if constexpr (TrackHandles)
+            {
+                m_handles.positions.data()[entry.handle] = pos;
+            }
+
+            m_heap.data()[pos] = std::move(entry);
+        }
+
+        // Restores the heap order after elements were appended past the first oldSize ones.
+        void restore_heap(size_type oldSize)
+        {
+            const auto newSize = m_heap.size();
+            if (newSize - oldSize >= oldSize)
+            {
+                heapify();
+                return;
+            }
+
+            for (auto pos = oldSize; pos != newSize; ++pos)
+            {
+                sift_up(pos);
+            }
+        }
+
+        void heapify()
+        {
+            const auto size = m_heap.size();
+            if (size < 2)
+                return;
+
+            for (auto pos = (size - 2) / D + 1; pos-- != 0;)
+            {
+                sift_down(pos);
+            }
+        }
+
+        // Both sifts move a hole instead of swapping, one move per level.
+        void sift_up(size_type pos)
+        {
+            const auto heap = m_heap.data();
+            Entry entry = std::move(heap[pos]);
+
+            while (pos != 0)
+            {
+                const auto parent = (pos - 1) / D;
+                if (!m_compare(value_of(heap[parent]), value_of(entry)))
+                    break;
+
+                place(pos, std::move(heap[parent]));
+                pos = parent;
+            }
+
+            place(pos, std::move(entry));
+        }
+
+        void sift_down(size_type pos)
+        {
+            const auto heap = m_heap.data();
+            const auto size = m_heap.size();
+            Entry entry = std::move(heap[pos]);
+
+            while (true)
+            {
+                const auto firstChild = D * pos + 1;
+                if (firstChild >= size)
+                    break;
+
+                const auto lastChild = std::min(firstChild + D, size);
+                auto best = firstChild;
+                for (auto child = firstChild + 1; child < lastChild; ++child)
+                {
+                    if (m_compare(value_of(heap[best]), value_of(heap[child])))
+                        best = child;
+                }
+
+                if (!m_compare(value_of(entry), value_of(heap[best])))
+                    break;
+
+                place(pos, std::move(heap[best]));
+                pos = best;
+            }
+
+            place(pos, std::move(entry));
+        }
+
+    private:
+        Vector<Entry, Entry_allocator> m_heap;
+        std::conditional_t<TrackHandles, HandleTable, NoHandleTable> m_handles;
+        Compare m_compare;
+    };
+
+} // namespace stl_container_impl
@@ -0,0 +1,294 @@
+#pragma once
+
+#include "vector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace stl_container_impl
+{
+    class ReclamationRegistry;
+
+    namespace detail
+    {
+        // Type-erased view of a ReclaimableVector used by ReclamationRegistry.
+        class ReclaimableEntry
+        {
+        public:
+            ReclaimableEntry(const ReclaimableEntry&) = delete;
+            ReclaimableEntry& operator=(const ReclaimableEntry&) = delete;
+
+        protected:
+            ReclaimableEntry() = default;
+            ~ReclaimableEntry() = default;
+
+        private:
+            friend class stl_container_impl::ReclamationRegistry;
+
+            // Bytes trim() would free, or 0 if the vector is not a candidate in this pass.
+            // Called once per pass; advances the hysteresis state.
+            virtual std::size_t try_measure() noexcept = 0;
+            // Frees the slack measured above, returns the number of bytes released.
+            virtual std::size_t try_trim() noexcept = 0;
+
+        private:
+            std::size_t m_registryIndex = 0;
+        };
+
+    } // namespace detail
+
+    /*---------------------------------------------------------------------------------------------
+     * Process-wide list of ReclaimableVectors whose spare capacity can be released on demand,
+     * e.g. from a memory pressure handler after a traffic spike.
+     *
+     * trim(budget) shrinks the vectors with the most slack first and stops once budget bytes are
+     * reclaimed. Hysteresis keeps it from thrashing hot vectors:
+     *  - only vectors that are more than half empty are candidates;
+     *  - a trimmed vector keeps a quarter of its size as headroom;
+     *  - vectors locked by their owner at the moment are skipped, never waited for;
+     *  - a vector that grew back past its trimmed capacity is left alone for the next few passes,
+     *    twice as many each time it happens again, and back to one once it stays within its
+     *    trimmed capacity for a pass.
+     *
+     * Shrinking copies the elements into a smaller buffer, so a trim briefly needs the new buffer
+     * in addition to the old one. Allocation failures just leave the vector as is.
+     -----------------------------------------------------------------------------------------------*/
+    class ReclamationRegistry
+    {
+    public:
+        ReclamationRegistry() = default;
+        ReclamationRegistry(const ReclamationRegistry&) = delete;
+        ReclamationRegistry& operator=(const ReclamationRegistry&) = delete;
+
+        static ReclamationRegistry& instance()
+        {
+            static ReclamationRegistry registry;
+            return registry;
+        }
+
+        // Returns the number of bytes released.
+        std::size_t trim(std::size_t budget = std::numeric_limits<std::size_t>::max())
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_candidates.clear();
+            for (auto entry : m_entries)
+            {
+                const auto slack = entry->try_measure();
+                if (slack != 0)
+                {
+                    m_candidates.push_back(Candidate{ slack, entry });
+                }
+            }
+
+            std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate& lhs, const Candidate& rhs) {
+                return lhs.slack > rhs.slack;
+            });
+
+            std::size_t reclaimed = 0;
+            for (const auto& candidate : m_candidates)
+            {
+                if (reclaimed >= budget)
+                    break;
+
+                reclaimed += candidate.entry->try_trim();
+            }
+
+            m_totalReclaimed.fetch_add(reclaimed, std::memory_order_relaxed);
+            return reclaimed;
+        }
+
+        // Bytes released by all trim() calls so far.
+        std::size_t total_reclaimed() const noexcept
+        {
+            return m_totalReclaimed.load(std::memory_order_relaxed);
+        }
+
+        std::size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+    private:
+        template <class T, class Allocator>
+        friend class ReclaimableVector;
+
+        struct Candidate
+        {
+            std::size_t slack;
+            detail::ReclaimableEntry* entry;
+        };
+
+        void add(detail::ReclaimableEntry& entry)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // Room for every entry as a candidate, so trim() never allocates before it frees memory
+            const auto entryCount = m_entries.size() + 1;
+            if (m_candidates.capacity() < entryCount)
+            {
+                m_candidates.reserve(std::max(entryCount, 2 * m_candidates.capacity()));
+            }
+
+            entry.m_registryIndex = m_entries.size();
+            m_entries.push_back(&entry);
+        }
+
+        // Waits for a running trim(), so the entry is never trimmed after this returns.
+        void remove(detail::ReclaimableEntry& entry) noexcept
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            const auto last = m_entries.back();
+            last->m_registryIndex = entry.m_registryIndex;
+            m_entries[entry.m_registryIndex] = last;
+            m_entries.pop_back();
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        Vector<detail::ReclaimableEntry*> m_entries;
+        Vector<Candidate> m_candidates; // reserved in add(), so trim() does not allocate
+        std::atomic<std::size_t> m_totalReclaimed{ 0 };
+    };
+
+    /*---------------------------------------------------------------------------------------------
+     * Vector registered with a ReclamationRegistry for its whole lifetime.
+     *
+     * Because trim() may run on another thread, the vector is only reachable through lock(),
+     * which holds the vector's own mutex for the lifetime of the returned handle. The object is
+     * registered by address and therefore neither copyable nor movable.
+     -----------------------------------------------------------------------------------------------*/
+    template <class T, class Allocator = std::allocator<T>>
+    class ReclaimableVector : private detail::ReclaimableEntry
+    {
+    public:
+        using vector_type = Vector<T, Allocator>;
+        using size_type = typename vector_type::size_type;
+
+        class Locked
+        {
+        public:
+            vector_type& operator*() const noexcept
+            {
+                return *m_vector;
+            }
+
+            vector_type* operator->() const noexcept
+            {
+                return m_vector;
+            }
+
+        private:
+            friend class ReclaimableVector;
+
+            Locked(std::mutex& mutex, vector_type& vector)
+                : m_lock(mutex)
+                , m_vector(&vector)
+            {
+            }
+
+        private:
+            std::unique_lock<std::mutex> m_lock;
+            vector_type* m_vector;
+        };
+
+    public:
+        explicit ReclaimableVector(ReclamationRegistry& registry = ReclamationRegistry::instance())
+            : m_registry(registry)
+        {
+            m_registry.add(*this);
+        }
+
+        ~ReclaimableVector()
+        {
+            m_registry.remove(*this);
+        }
+
+        Locked lock()
+        {
+            return Locked{ m_mutex, m_vector };
+        }
+
+    private:
+        static constexpr unsigned max_cooldown = 64;
+
+        std::size_t try_measure() noexcept override
+        {
+            std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+            if (!lock.owns_lock())
+                return 0;
+
+            if (m_cooldown != 0)
+            {
+                --m_cooldown;
+                return 0;
+            }
+
+            const auto capacity = m_vector.capacity();
+            if (m_trimmedCapacity != 0)
+            {
+                if (capacity > m_trimmedCapacity)
+                {
+                    // Grew back after the last trim: back off
+                    m_backoff = std::min(m_backoff * 2, max_cooldown);
+                    m_cooldown = m_backoff;
+                    m_trimmedCapacity = 0;
+                    return 0;
+                }
+
+                // Stayed within the trimmed capacity for a pass: earlier growth is forgiven
+                m_backoff = 1;
+            }
+
+            const auto target = target_capacity();
+            if (capacity - m_vector.size() <= m_vector.size() || target >= capacity)
+                return 0;
+
+            return (capacity - target) * sizeof(T);
+        }
+
+        std::size_t try_trim() noexcept override
+        {
+            std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+            if (!lock.owns_lock())
+                return 0;
+
+            const auto oldCapacity = m_vector.capacity();
+            try
+            {
+                m_vector.shrink_to(target_capacity());
+            }
+            catch (...)
+            {
+                return 0;
+            }
+
+            m_trimmedCapacity = m_vector.capacity();
+            return (oldCapacity - m_trimmedCapacity) * sizeof(T);
+        }
+
+        size_type target_capacity() const noexcept
+        {
+            const auto size = m_vector.size();
+            return size + size / 4;
+        }
+
+    private:
+        ReclamationRegistry& m_registry;
+        std::mutex m_mutex;
+        vector_type m_vector;
+
+        // Hysteresis state, guarded by m_mutex
+        size_type m_trimmedCapacity = 0;
+        unsigned m_cooldown = 0;
+        unsigned m_backoff = 1;
+    };
+
+} // namespace stl_container_impl
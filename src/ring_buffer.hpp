@@ -0,0 +1,467 @@
+#pragma once
+
+#include "index_iterator.hpp"
+#include "span.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace stl_container_impl
+{
+    namespace detail
+    {
+        // Smallest power of two not less than value, value must be non-zero.
+        template <typename SizeType>
+        SizeType round_up_to_power_of_two(SizeType value) noexcept
+        {
+            SizeType result = 1;
+            while (result < value)
+            {
+                result <<= 1;
+            }
+
+            return result;
+        }
+
+    } // namespace detail
+
+    /*---------------------------------------------------------------------------------------------
+     * Growable double-ended queue stored in a single circular buffer.
+     *
+     * Capacity is always a power of two, so a logical index maps to a slot with a mask instead of
+     * a division. Pushing and popping at either end is amortized O(1). When the buffer is full it
+     * doubles, relocating the (at most two) contiguous segments to the start of the new buffer.
+     * segments() exposes those segments directly, e.g. for a writev() of queued bytes.
+     -----------------------------------------------------------------------------------------------*/
+    template <class T, class Allocator = std::allocator<T>>
+    class RingBuffer
+    {
+        using Allocator_traits = std::allocator_traits<Allocator>;
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = typename Allocator_traits::size_type;
+        using difference_type = typename Allocator_traits::difference_type;
+        using pointer = typename Allocator_traits::pointer;
+        using const_pointer = typename Allocator_traits::const_pointer;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        using iterator = index_iterator<RingBuffer, T>;
+        using const_iterator = index_iterator<const RingBuffer, const T>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    public:
+        RingBuffer() = default;
+
+        RingBuffer(const RingBuffer& other)
+            : m_allocator(Allocator_traits::select_on_container_copy_construction(other.m_allocator))
+        {
+            reserve(other.size());
+            for (const auto& value : other)
+                emplace_back(value);
+        }
+
+        RingBuffer(RingBuffer&& other) noexcept
+            : m_buffer(other.m_buffer)
+            , m_capacity(other.m_capacity)
+            , m_head(other.m_head)
+            , m_size(other.m_size)
+            , m_allocator(std::move(other.m_allocator))
+        {
+            other.m_buffer = nullptr;
+            other.m_capacity = other.m_head = other.m_size = 0;
+        }
+
+        RingBuffer(std::initializer_list<T> list)
+        {
+            reserve(list.size());
+            for (const auto& value : list)
+                emplace_back(value);
+        }
+
+        ~RingBuffer()
+        {
+            clear();
+            Allocator_traits::deallocate(m_allocator, m_buffer, m_capacity);
+        }
+
+        RingBuffer& operator=(const RingBuffer& other)
+        {
+            if (std::addressof(other) != this)
+            {
+                RingBuffer copy(other);
+                swap(copy);
+            }
+
+            return *this;
+        }
+
+        RingBuffer& operator=(RingBuffer&& other) noexcept
+        {
+            if (std::addressof(other) != this)
+            {
+                RingBuffer moved(std::move(other));
+                swap(moved);
+            }
+
+            return *this;
+        }
+
+        void swap(RingBuffer& other) noexcept
+        {
+            using std::swap;
+            swap(m_buffer, other.m_buffer);
+            swap(m_capacity, other.m_capacity);
+            swap(m_head, other.m_head);
+            swap(m_size, other.m_size);
+            swap(m_allocator, other.m_allocator);
+        }
+
+        // Capacity is rounded up to the next power of two.
+        void reserve(size_type count)
+        {
+            if (count <= m_capacity)
+                return;
+
+            if (count > max_size())
+                throw std::length_error("RingBuffer::reserve");
+
+            reallocate(detail::round_up_to_power_of_two(count));
+        }
+
+        template <typename... Args>
+        reference emplace_back(Args&&... args)
+        {
+            if (m_size == m_capacity)
+            {
+                const auto slot = grow_and_construct(false, std::forward<Args>(args)...);
+                ++m_size;
+
+                return *slot;
+            }
+
+            const auto slot = m_buffer + physical_index(m_size);
+            Allocator_traits::construct(m_allocator, slot, std::forward<Args>(args)...);
+            ++m_size;
+
+            return *slot;
+        }
+
+        template <typename... Args>
+        reference emplace_front(Args&&... args)
+        {
+            if (m_size == m_capacity)
+            {
+                const auto slot = grow_and_construct(true, std::forward<Args>(args)...);
+                m_head = m_capacity - 1;
+                ++m_size;
+
+                return *slot;
+            }
+
+            const auto head = (m_head - 1) & (m_capacity - 1);
+            Allocator_traits::construct(m_allocator, m_buffer + head, std::forward<Args>(args)...);
+            m_head = head;
+            ++m_size;
+
+            return m_buffer[head];
+        }
+
+        void push_back(const_reference value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(value_type&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void push_front(const_reference value)
+        {
+            emplace_front(value);
+        }
+
+        void push_front(value_type&& value)
+        {
+            emplace_front(std::move(value));
+        }
+
+        void pop_front() noexcept
+        {
+            Allocator_traits::destroy(m_allocator, m_buffer + m_head);
+            m_head = (m_head + 1) & (m_capacity - 1);
+            --m_size;
+        }
+
+        // Removes the first count elements, e.g. the part of segments() consumed by a partial write.
+        void pop_front(size_type count) noexcept
+        {
+            for (; count != 0; --count)
+            {
+                pop_front();
+            }
+        }
+
+        void pop_back() noexcept
+        {
+            --m_size;
+            Allocator_traits::destroy(m_allocator, m_buffer + physical_index(m_size));
+        }
+
+        void clear() noexcept
+        {
+            const auto segments = this->segments();
+            destroy_range(segments.first.data(), segments.first.data() + segments.first.size());
+            destroy_range(segments.second.data(), segments.second.data() + segments.second.size());
+
+            m_head = 0;
+            m_size = 0;
+        }
+
+    public:
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        size_type max_size() const noexcept
+        {
+            return (std::numeric_limits<difference_type>::max() >> 1) + 1;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        // The elements in order as at most two contiguous ranges; the second one is empty unless the contents wrap around.
+        std::pair<Span<T>, Span<T>> segments() noexcept
+        {
+            const auto firstSize = std::min(m_size, m_capacity - m_head);
+            return { Span<T>{ m_buffer + m_head, firstSize }, Span<T>{ m_buffer, m_size - firstSize } };
+        }
+
+        std::pair<Span<const T>, Span<const T>> segments() const noexcept
+        {
+            const auto firstSize = std::min(m_size, m_capacity - m_head);
+            return { Span<const T>{ m_buffer + m_head, firstSize }, Span<const T>{ m_buffer, m_size - firstSize } };
+        }
+
+        iterator begin() noexcept
+        {
+            return iterator{ this, 0 };
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return cbegin();
+        }
+
+        const_iterator cbegin() const noexcept
+        {
+            return const_iterator{ this, 0 };
+        }
+
+        iterator end() noexcept
+        {
+            return iterator{ this, static_cast<difference_type>(m_size) };
+        }
+
+        const_iterator end() const noexcept
+        {
+            return cend();
+        }
+
+        const_iterator cend() const noexcept
+        {
+            return const_iterator{ this, static_cast<difference_type>(m_size) };
+        }
+
+        Allocator get_allocator() const noexcept
+        {
+            return m_allocator;
+        }
+
+        reference operator[](size_type pos) noexcept
+        {
+            return m_buffer[physical_index(pos)];
+        }
+
+        const_reference operator[](size_type pos) const noexcept
+        {
+            return m_buffer[physical_index(pos)];
+        }
+
+        reference at(size_type pos)
+        {
+            if (pos >= m_size)
+            {
+                throw std::out_of_range("RingBuffer::at");
+            }
+
+            return (*this)[pos];
+        }
+
+        const_reference at(size_type pos) const
+        {
+            if (pos >= m_size)
+            {
+                throw std::out_of_range("RingBuffer::at");
+            }
+
+            return (*this)[pos];
+        }
+
+        reference front()
+        {
+            return m_buffer[m_head];
+        }
+
+        const_reference front() const
+        {
+            return m_buffer[m_head];
+        }
+
+        reference back()
+        {
+            return (*this)[m_size - 1];
+        }
+
+        const_reference back() const
+        {
+            return (*this)[m_size - 1];
+        }
+
+    private:
+        size_type physical_index(size_type pos) const noexcept
+        {
+            return (m_head + pos) & (m_capacity - 1);
+        }
+
+        size_type grown_capacity() const
+        {
+            if (m_capacity > max_size() / 2)
+                throw std::length_error("RingBuffer::grow");
+
+            return m_capacity == 0 ? 1 : m_capacity * 2;
+        }
+
+        /*---------------------------------------------------------------------------------------------
+         * Allocates a buffer twice as large and constructs the new element in it, at the slot just
+         * before the relocated elements (atFront) or just after them. The element is constructed
+         * before the old elements are relocated: args may refer to one of them.
+         -----------------------------------------------------------------------------------------------*/
+        template <typename... Args>
+        pointer grow_and_construct(bool atFront, Args&&... args)
+        {
+            const auto newCapacity = grown_capacity();
+            pointer buff = Allocator_traits::allocate(m_allocator, newCapacity);
+            const auto slot = buff + (atFront ? newCapacity - 1 : m_size);
+
+            try
+            {
+                Allocator_traits::construct(m_allocator, slot, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                Allocator_traits::deallocate(m_allocator, buff, newCapacity);
+                throw;
+            }
+
+            try
+            {
+                relocate_to(buff, newCapacity);
+            }
+            catch (...)
+            {
+                Allocator_traits::destroy(m_allocator, slot);
+                Allocator_traits::deallocate(m_allocator, buff, newCapacity);
+                throw;
+            }
+
+            return slot;
+        }
+
+        // Relocates both segments to the start of a new buffer of newCapacity (a power of two).
+        void reallocate(size_type newCapacity)
+        {
+            pointer buff = Allocator_traits::allocate(m_allocator, newCapacity);
+
+            try
+            {
+                relocate_to(buff, newCapacity);
+            }
+            catch (...)
+            {
+                Allocator_traits::deallocate(m_allocator, buff, newCapacity);
+                throw;
+            }
+        }
+
+        // Moves both segments to the start of buff and makes it the buffer. Provides strong guarantee;
+        // on exception buff is still owned by the caller.
+        void relocate_to(pointer buff, size_type newCapacity)
+        {
+            pointer finish = buff;
+            const auto segments = this->segments();
+
+            try
+            {
+                move_uninitialized_if_noexcept(segments.first.data(), segments.first.data() + segments.first.size(), finish);
+                move_uninitialized_if_noexcept(segments.second.data(), segments.second.data() + segments.second.size(), finish);
+            }
+            catch (...)
+            {
+                destroy_range(buff, finish);
+                throw;
+            }
+
+            const auto size = m_size;
+            clear();
+            Allocator_traits::deallocate(m_allocator, m_buffer, m_capacity);
+
+            m_buffer = buff;
+            m_capacity = newCapacity;
+            m_head = 0;
+            m_size = size;
+        }
+
+        void move_uninitialized_if_noexcept(pointer fromFirst, pointer fromLast, pointer& to)
+        {
+            for (; fromFirst != fromLast; ++fromFirst, ++to)
+            {
+                Allocator_traits::construct(m_allocator, to, std::move_if_noexcept(*fromFirst));
+            }
+        }
+
+        void destroy_range(pointer first, pointer last) noexcept
+        {
+            for (; first != last; ++first)
+            {
+                Allocator_traits::destroy(m_allocator, first);
+            }
+        }
+
+    private:
+        pointer m_buffer = nullptr;
+        size_type m_capacity = 0; // zero or a power of two
+        size_type m_head = 0;
+        size_type m_size = 0;
+
+        Allocator m_allocator;
+    };
+
+} // namespace stl_container_impl
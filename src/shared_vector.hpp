@@ -0,0 +1,462 @@
+#pragma once
+
+#include "vector.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace stl_container_impl
+{
+    /*---------------------------------------------------------------------------------------------
+     * Vector with shared, reference counted storage and copy-on-write semantics.
+     *
+     * Copies are O(1) and share the same buffer. Every mutating method first makes the storage
+     * unique, copying the elements only if another SharedVector still refers to them,
+     * so a snapshot never observes changes made through a later copy.
+     *
+     * The reference count is released with release ordering and checked with an acquire load
+     * before the storage is modified in place. A reader on another thread that drops its copy
+     * therefore has finished reading before the owner writes. shared_ptr::use_count() is a
+     * relaxed load and gives no such guarantee.
+     -----------------------------------------------------------------------------------------------*/
+    template <class T, class Allocator = std::allocator<T>>
+    class SharedVector
+    {
+        struct Block;
+
+        using Block_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+        using Block_allocator_traits = std::allocator_traits<Block_allocator>;
+
+    public:
+        using storage_type = Vector<T, Allocator>;
+
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = typename storage_type::size_type;
+        using difference_type = typename storage_type::difference_type;
+        using const_pointer = typename storage_type::const_pointer;
+        using const_reference = typename storage_type::const_reference;
+        using const_iterator = typename storage_type::const_iterator;
+
+    public:
+        SharedVector() = default;
+
+        explicit SharedVector(storage_type storage)
+            : m_block(make_block(std::move(storage)))
+        {
+        }
+
+        SharedVector(std::initializer_list<T> list)
+            : m_block(make_block(storage_type(list)))
+        {
+        }
+
+        SharedVector(const SharedVector& other) noexcept
+            : m_block(other.m_block)
+        {
+            if (m_block)
+            {
+                m_block->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        SharedVector(SharedVector&& other) noexcept
+            : m_block(std::exchange(other.m_block, nullptr))
+        {
+        }
+
+        ~SharedVector()
+        {
+            release();
+        }
+
+        SharedVector& operator=(const SharedVector& other) noexcept
+        {
+            SharedVector(other).swap(*this);
+            return *this;
+        }
+
+        SharedVector& operator=(SharedVector&& other) noexcept
+        {
+            SharedVector(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        void swap(SharedVector& other) noexcept
+        {
+            std::swap(m_block, other.m_block);
+        }
+
+        template <typename... Args>
+        void emplace_back(Args&&... args)
+        {
+            mutate().emplace_back(std::forward<Args>(args)...);
+        }
+
+        void push_back(const T& value)
+        {
+            mutate().push_back(value);
+        }
+
+        void push_back(T&& value)
+        {
+            mutate().push_back(std::move(value));
+        }
+
+        void pop_back()
+        {
+            mutate().pop_back();
+        }
+
+        void clear()
+        {
+            if (!m_block)
+            {
+                return;
+            }
+
+            if (unique())
+            {
+                m_block->vector.clear();
+            }
+            else
+            {
+                release();
+            }
+        }
+
+        // Assigns value to the element at pos, detaching from shared storage first.
+        void set(size_type pos, T value)
+        {
+            mutate().data()[pos] = std::move(value);
+        }
+
+        /*---------------------------------------------------------------------------------------------
+         * Returns the underlying Vector for in-place modification, copying it first if it is shared.
+         * The reference is invalidated as soon as *this is copied.
+         -----------------------------------------------------------------------------------------------*/
+        storage_type& mutate()
+        {
+            if (!m_block)
+            {
+                m_block = make_block(storage_type());
+            }
+            else if (!unique())
+            {
+                auto copy = make_block(storage_type(m_block->vector));
+                release();
+                m_block = copy;
+            }
+
+            return m_block->vector;
+        }
+
+    public:
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_block ? m_block->vector.size() : 0;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return m_block ? m_block->vector.cbegin() : const_iterator{};
+        }
+
+        const_iterator end() const noexcept
+        {
+            return m_block ? m_block->vector.cend() : const_iterator{};
+        }
+
+        const_pointer data() const noexcept
+        {
+            return m_block ? m_block->vector.data() : const_pointer{};
+        }
+
+        const_reference operator[](size_type pos) const noexcept
+        {
+            return m_block->vector.data()[pos];
+        }
+
+        const_reference at(size_type pos) const
+        {
+            if (pos >= size())
+            {
+                throw std::out_of_range("SharedVector::at");
+            }
+
+            return (*this)[pos];
+        }
+
+        const_reference front() const
+        {
+            return m_block->vector.front();
+        }
+
+        const_reference back() const
+        {
+            return m_block->vector.back();
+        }
+
+        // True if both vectors refer to the same buffer.
+        bool shares_storage_with(const SharedVector& other) const noexcept
+        {
+            return m_block == other.m_block;
+        }
+
+    private:
+        struct Block
+        {
+            explicit Block(storage_type&& storage)
+                : vector(std::move(storage))
+            {
+            }
+
+            storage_type vector;
+            std::atomic<std::size_t> refs{ 1 };
+        };
+
+        static Block* make_block(storage_type&& storage)
+        {
+            Block_allocator allocator;
+            Block* block = Block_allocator_traits::allocate(allocator, 1);
+            try
+            {
+                Block_allocator_traits::construct(allocator, block, std::move(storage));
+            }
+            catch (...)
+            {
+                Block_allocator_traits::deallocate(allocator, block, 1);
+                throw;
+            }
+
+            return block;
+        }
+
+        // Drops this reference; the last one destroys the storage.
+        void release() noexcept
+        {
+            auto block = std::exchange(m_block, nullptr);
+            if (block && block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                Block_allocator allocator;
+                Block_allocator_traits::destroy(allocator, block);
+                Block_allocator_traits::deallocate(allocator, block, 1);
+            }
+        }
+
+        // Acquire pairs with the release in other copies' release(), so their reads of the
+        // storage happen before the caller modifies it.
+        bool unique() const noexcept
+        {
+            return m_block->refs.load(std::memory_order_acquire) == 1;
+        }
+
+    private:
+        Block* m_block = nullptr;
+    };
+
+    /*---------------------------------------------------------------------------------------------
+     * Publication point for a SharedVector that one writer replaces while many threads read it.
+     *
+     * Readers go through a Reader handle owning one of MaxReaders slots. Reading only announces
+     * the current epoch in the reader's own slot and loads the published pointer, so readers
+     * never wait for writers or for each other. publish() swaps the pointer and frees replaced
+     * versions once no reader slot still announces an epoch from before the swap
+     * (epoch-based reclamation). Concurrent publish() calls are serialized by a mutex.
+     -----------------------------------------------------------------------------------------------*/
+    template <class T, class Allocator = std::allocator<T>, std::size_t MaxReaders = 64>
+    class AtomicSharedVector
+    {
+        struct Node
+        {
+            SharedVector<T, Allocator> value;
+        };
+
+        struct Retired
+        {
+            Node* node;
+            std::uint64_t epoch;
+        };
+
+        // Each slot sits on its own cache line so pinning does not bounce lines between readers.
+        struct alignas(64) Slot
+        {
+            std::atomic<std::uint64_t> epoch{ 0 }; // 0 - not reading
+            std::atomic<bool> used{ false };
+        };
+
+    public:
+        using value_type = SharedVector<T, Allocator>;
+
+        class Reader
+        {
+        public:
+            explicit Reader(AtomicSharedVector& owner)
+                : m_owner(owner)
+                , m_slot(owner.claim_slot())
+            {
+            }
+
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            ~Reader()
+            {
+                m_slot.used.store(false);
+            }
+
+            // O(1) snapshot of the currently published vector.
+            value_type acquire()
+            {
+                Pin pin{ *this };
+                return pin.node->value;
+            }
+
+            // Calls fn(const SharedVector&) on the published vector without touching its reference count.
+            // fn must not call back into this Reader.
+            template <typename Fn>
+            decltype(auto) read(Fn&& fn)
+            {
+                Pin pin{ *this };
+                return std::forward<Fn>(fn)(static_cast<const value_type&>(pin.node->value));
+            }
+
+        private:
+            struct Pin
+            {
+                explicit Pin(Reader& reader) noexcept
+                    : slot(reader.m_slot)
+                {
+                    slot.epoch.store(reader.m_owner.m_epoch.load());
+                    node = reader.m_owner.m_current.load();
+                }
+
+                ~Pin()
+                {
+                    slot.epoch.store(0);
+                }
+
+                Slot& slot;
+                Node* node;
+            };
+
+            AtomicSharedVector& m_owner;
+            Slot& m_slot;
+        };
+
+    public:
+        AtomicSharedVector()
+            : m_current(new Node{})
+        {
+        }
+
+        explicit AtomicSharedVector(value_type value)
+            : m_current(new Node{ std::move(value) })
+        {
+        }
+
+        AtomicSharedVector(const AtomicSharedVector&) = delete;
+        AtomicSharedVector& operator=(const AtomicSharedVector&) = delete;
+
+        // All Readers must be destroyed before the publisher.
+        ~AtomicSharedVector()
+        {
+            for (auto& retired : m_retired)
+            {
+                delete retired.node;
+            }
+
+            delete m_current.load();
+        }
+
+        void publish(value_type value)
+        {
+            auto node = std::make_unique<Node>(Node{ std::move(value) });
+
+            std::lock_guard<std::mutex> lock(m_writerMutex);
+            m_retired.reserve(m_retired.size() + 1); // push_back below must not throw after the swap
+
+            auto old = m_current.exchange(node.release());
+            const auto epoch = m_epoch.fetch_add(1) + 1;
+            m_retired.push_back(Retired{ old, epoch });
+
+            reclaim();
+        }
+
+        // Snapshot for the writer thread itself; readers should use Reader::acquire.
+        value_type load_for_writer() const
+        {
+            std::lock_guard<std::mutex> lock(m_writerMutex);
+            return m_current.load()->value;
+        }
+
+    private:
+        Slot& claim_slot()
+        {
+            for (auto& slot : m_slots)
+            {
+                bool expected = false;
+                if (!slot.used.load() && slot.used.compare_exchange_strong(expected, true))
+                {
+                    return slot;
+                }
+            }
+
+            throw std::length_error("AtomicSharedVector::Reader");
+        }
+
+        // Frees retired nodes that no pinned reader can still reference. Called under m_writerMutex.
+        void reclaim() noexcept
+        {
+            auto minEpoch = std::numeric_limits<std::uint64_t>::max();
+            for (auto& slot : m_slots)
+            {
+                const auto epoch = slot.epoch.load();
+                if (epoch != 0 && epoch < minEpoch)
+                {
+                    minEpoch = epoch;
+                }
+            }
+
+            auto kept = m_retired.begin();
+            for (auto it = m_retired.begin(); it != m_retired.end(); ++it)
+            {
+                if (it->epoch <= minEpoch)
+                {
+                    delete it->node;
+                }
+                else
+                {
+                    *kept = *it;
+                    ++kept;
+                }
+            }
+
+            while (m_retired.end() != kept)
+            {
+                m_retired.pop_back();
+            }
+        }
+
+    private:
+        std::atomic<Node*> m_current;
+        std::atomic<std::uint64_t> m_epoch{ 1 };
+        std::array<Slot, MaxReaders> m_slots;
+
+        mutable std::mutex m_writerMutex;
+        Vector<Retired> m_retired;
+    };
+
+} // namespace stl_container_impl
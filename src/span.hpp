@@ -0,0 +1,99 @@
+#pragma once
+
+// Minimal non-owning view over a contiguous range, a C++17 stand-in for std::span.
+
+#include "vector_iterator.hpp"
+#include <cstddef>
+#include <type_traits>
+
+namespace stl_container_impl
+{
+    template <typename T>
+    class Span
+    {
+        template <typename U>
+        using convertible_from = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>;
+
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        using iterator = stl_container_impl::pointer_wrapper_iterator<pointer, Span>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+
+    public:
+        Span() noexcept = default;
+
+        Span(pointer data, size_type size) noexcept
+            : m_data(data)
+            , m_size(size)
+        {
+        }
+
+        template <typename U, typename = convertible_from<U>>
+        Span(const Span<U>& other) noexcept
+            : m_data(other.data())
+            , m_size(other.size())
+        {
+        }
+
+        iterator begin() const noexcept
+        {
+            return iterator{ m_data };
+        }
+
+        iterator end() const noexcept
+        {
+            return iterator{ m_data + m_size };
+        }
+
+        pointer data() const noexcept
+        {
+            return m_data;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        size_type size_bytes() const noexcept
+        {
+            return m_size * sizeof(T);
+        }
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        reference operator[](size_type pos) const noexcept
+        {
+            return m_data[pos];
+        }
+
+        reference front() const noexcept
+        {
+            return *m_data;
+        }
+
+        reference back() const noexcept
+        {
+            return m_data[m_size - 1];
+        }
+
+        Span subspan(size_type offset, size_type count) const noexcept
+        {
+            return Span{ m_data + offset, count };
+        }
+
+    private:
+        pointer m_data = nullptr;
+        size_type m_size = 0;
+    };
+
+} // namespace stl_container_impl
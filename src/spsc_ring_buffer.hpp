@@ -0,0 +1,136 @@
+#pragma once
+
+#include "ring_buffer.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace stl_container_impl
+{
+    /*---------------------------------------------------------------------------------------------
+     * Fixed capacity lock-free queue for handing elements from exactly one producer thread to
+     * exactly one consumer thread.
+     *
+     * m_tail is written only by the producer and m_head only by the consumer; both are monotonic
+     * counters mapped to slots with a mask. Each side keeps a cached copy of the other side's
+     * counter and re-reads the shared one only when the cache says the queue is full (producer)
+     * or empty (consumer), which keeps cache line traffic down.
+     -----------------------------------------------------------------------------------------------*/
+    template <class T, class Allocator = std::allocator<T>>
+    class SpscRingBuffer
+    {
+        using Allocator_traits = std::allocator_traits<Allocator>;
+
+        static constexpr std::size_t cache_line_size = 64;
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = typename Allocator_traits::size_type;
+        using pointer = typename Allocator_traits::pointer;
+
+    public:
+        // Capacity is rounded up to the next power of two.
+        explicit SpscRingBuffer(size_type capacity, const Allocator& allocator = Allocator())
+            : m_allocator(allocator)
+        {
+            if (capacity == 0)
+                throw std::length_error("SpscRingBuffer::SpscRingBuffer");
+
+            m_capacity = detail::round_up_to_power_of_two(capacity);
+            m_buffer = Allocator_traits::allocate(m_allocator, m_capacity);
+        }
+
+        SpscRingBuffer(const SpscRingBuffer&) = delete;
+        SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+        ~SpscRingBuffer()
+        {
+            const auto tail = m_tail.load(std::memory_order_relaxed);
+            for (auto head = m_head.load(std::memory_order_relaxed); head != tail; ++head)
+            {
+                Allocator_traits::destroy(m_allocator, m_buffer + (head & (m_capacity - 1)));
+            }
+
+            Allocator_traits::deallocate(m_allocator, m_buffer, m_capacity);
+        }
+
+        // Producer side. Returns false if the queue is full.
+        template <typename... Args>
+        bool try_emplace(Args&&... args)
+        {
+            const auto tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_cachedHead == m_capacity)
+            {
+                m_cachedHead = m_head.load(std::memory_order_acquire);
+                if (tail - m_cachedHead == m_capacity)
+                {
+                    return false;
+                }
+            }
+
+            Allocator_traits::construct(m_allocator, m_buffer + (tail & (m_capacity - 1)), std::forward<Args>(args)...);
+            m_tail.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        bool try_push(const T& value)
+        {
+            return try_emplace(value);
+        }
+
+        bool try_push(T&& value)
+        {
+            return try_emplace(std::move(value));
+        }
+
+        // Consumer side. Moves the oldest element into out; returns false if the queue is empty.
+        bool try_pop(T& out)
+        {
+            const auto head = m_head.load(std::memory_order_relaxed);
+            if (head == m_cachedTail)
+            {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+                if (head == m_cachedTail)
+                {
+                    return false;
+                }
+            }
+
+            const auto slot = m_buffer + (head & (m_capacity - 1));
+            out = std::move(*slot);
+            Allocator_traits::destroy(m_allocator, slot);
+            m_head.store(head + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        // Exact only when called while neither side is running.
+        size_type size_approx() const noexcept
+        {
+            return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+        }
+
+        size_type capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+    private:
+        pointer m_buffer = nullptr;
+        size_type m_capacity = 0;
+        Allocator m_allocator;
+
+        // Consumer owned
+        alignas(cache_line_size) std::atomic<size_type> m_head{ 0 };
+        size_type m_cachedTail = 0;
+
+        // Producer owned
+        alignas(cache_line_size) std::atomic<size_type> m_tail{ 0 };
+        size_type m_cachedHead = 0;
+    };
+
+} // namespace stl_container_impl
@@ -0,0 +1,588 @@
+#pragma once
+
+#include "trivially_relocatable.hpp"
+#include "vector_iterator.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace stl_container_impl
+{
+    /*---------------------------------------------------------------------------------------------
+     * Byte string with small string optimization.
+     *
+     * Up to InlineCapacity characters are stored inside the object itself; longer strings live
+     * in a heap buffer obtained from Allocator and grown geometrically like Vector's.
+     * Whether the string is inline is kept in the top bit of the size, not by a pointer into the
+     * object, so a String can be relocated with memcpy (see is_trivially_relocatable below).
+     * With the default InlineCapacity of 23 the object is 32 bytes.
+     *
+     * find() and compare() are built on memchr/memcmp, which the C library implements
+     * with vector instructions.
+     -----------------------------------------------------------------------------------------------*/
+    template <std::size_t InlineCapacity = 23, class Allocator = std::allocator<char>>
+    class BasicString
+    {
+        using Allocator_traits = std::allocator_traits<Allocator>;
+
+        static_assert(std::is_same<typename Allocator_traits::value_type, char>::value, "BasicString allocator must allocate char");
+
+    public:
+        using value_type = char;
+        using traits_type = std::char_traits<char>;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = char*;
+        using const_pointer = const char*;
+        using reference = char&;
+        using const_reference = const char&;
+
+        using iterator = stl_container_impl::pointer_wrapper_iterator<pointer, BasicString>;
+        using const_iterator = stl_container_impl::pointer_wrapper_iterator<const_pointer, BasicString>;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+        static constexpr size_type inline_capacity = InlineCapacity;
+
+    public:
+        BasicString() noexcept
+        {
+            m_impl.storage.local[0] = '\0';
+        }
+
+        explicit BasicString(const Allocator& allocator) noexcept
+            : m_impl(allocator)
+        {
+            m_impl.storage.local[0] = '\0';
+        }
+
+        BasicString(const char* str)
+            : BasicString(std::string_view(str))
+        {
+        }
+
+        BasicString(const char* str, size_type count)
+            : BasicString(std::string_view(str, count))
+        {
+        }
+
+        BasicString(size_type count, char ch)
+            : BasicString()
+        {
+            resize(count, ch);
+        }
+
+        explicit BasicString(std::string_view view)
+            : BasicString()
+        {
+            assign(view);
+        }
+
+        BasicString(const BasicString& other)
+            : BasicString()
+        {
+            allocator() = Allocator_traits::select_on_container_copy_construction(other.allocator());
+            assign(other.view());
+        }
+
+        BasicString(BasicString&& other) noexcept
+            : m_impl(std::move(other.allocator()))
+        {
+            std::memcpy(static_cast<void*>(&m_impl.storage), &other.m_impl.storage, sizeof(m_impl.storage));
+            m_impl.size = other.m_impl.size;
+
+            other.m_impl.size = 0;
+            other.m_impl.storage.local[0] = '\0';
+        }
+
+        ~BasicString()
+        {
+            release();
+        }
+
+        BasicString& operator=(const BasicString& other)
+        {
+            if (std::addressof(other) != this)
+            {
+                assign(other.view());
+            }
+
+            return *this;
+        }
+
+        BasicString& operator=(BasicString&& other) noexcept
+        {
+            if (std::addressof(other) != this)
+            {
+                release();
+
+                allocator() = std::move(other.allocator());
+                std::memcpy(static_cast<void*>(&m_impl.storage), &other.m_impl.storage, sizeof(m_impl.storage));
+                m_impl.size = other.m_impl.size;
+
+                other.m_impl.size = 0;
+                other.m_impl.storage.local[0] = '\0';
+            }
+
+            return *this;
+        }
+
+        BasicString& operator=(std::string_view view)
+        {
+            return assign(view);
+        }
+
+        BasicString& assign(std::string_view view)
+        {
+            // view may point into *this, so the old buffer is released only after copying from it
+            if (view.size() > capacity())
+            {
+                BasicString copy(allocator());
+                copy.reserve(view.size());
+                traits_type::copy(copy.data(), view.data(), view.size());
+                copy.set_size(view.size());
+                swap(copy);
+                return *this;
+            }
+
+            traits_type::move(data(), view.data(), view.size());
+            set_size(view.size());
+
+            return *this;
+        }
+
+        void swap(BasicString& other) noexcept
+        {
+            using std::swap;
+            swap(m_impl.storage, other.m_impl.storage);
+            swap(m_impl.size, other.m_impl.size);
+            swap(allocator(), other.allocator());
+        }
+
+        void reserve(size_type count)
+        {
+            if (count <= capacity())
+                return;
+
+            if (count > max_size())
+                throw std::length_error("BasicString::reserve");
+
+            reallocate(count);
+        }
+
+        void resize(size_type count, char ch = '\0')
+        {
+            const auto size = this->size();
+            if (count > size)
+            {
+                grow_to(count);
+                traits_type::assign(data() + size, count - size, ch);
+            }
+
+            set_size(count);
+        }
+
+        /*---------------------------------------------------------------------------------------------
+         * Makes room for count characters and calls op(data(), count) to write them directly into
+         * the buffer. op returns the final size, which must not exceed count. Characters past the
+         * old size are uninitialized when op runs, so nothing is zero-filled in advance.
+         -----------------------------------------------------------------------------------------------*/
+        template <typename Operation>
+        void resize_and_overwrite(size_type count, Operation op)
+        {
+            grow_to(count);
+
+            const auto buffer = data();
+            const auto newSize = static_cast<size_type>(std::move(op)(buffer, count));
+            m_impl.size = newSize | (m_impl.size & heap_flag);
+            buffer[newSize] = '\0';
+        }
+
+        void push_back(char ch)
+        {
+            const auto size = this->size();
+            grow_to(size + 1);
+            data()[size] = ch;
+            set_size(size + 1);
+        }
+
+        void pop_back() noexcept
+        {
+            set_size(size() - 1);
+        }
+
+        BasicString& append(const char* str, size_type count)
+        {
+            const auto size = this->size();
+            if (size + count > capacity())
+            {
+                // str may point into *this; copy it before the old buffer is released
+                BasicString grown(allocator());
+                grown.reserve(next_capacity(size + count));
+                traits_type::copy(grown.data(), data(), size);
+                traits_type::copy(grown.data() + size, str, count);
+                grown.set_size(size + count);
+                swap(grown);
+                return *this;
+            }
+
+            traits_type::move(data() + size, str, count);
+            set_size(size + count);
+
+            return *this;
+        }
+
+        BasicString& append(std::string_view view)
+        {
+            return append(view.data(), view.size());
+        }
+
+        BasicString& operator+=(std::string_view view)
+        {
+            return append(view);
+        }
+
+        BasicString& operator+=(char ch)
+        {
+            push_back(ch);
+            return *this;
+        }
+
+        void clear() noexcept
+        {
+            set_size(0);
+        }
+
+    public:
+        size_type find(char ch, size_type pos = 0) const noexcept
+        {
+            const auto size = this->size();
+            if (pos >= size)
+                return npos;
+
+            const auto found = traits_type::find(data() + pos, size - pos, ch);
+            return found ? static_cast<size_type>(found - data()) : npos;
+        }
+
+        size_type find(std::string_view needle, size_type pos = 0) const noexcept
+        {
+            const auto size = this->size();
+            if (needle.size() > size || pos > size - needle.size())
+                return npos;
+
+            if (needle.empty())
+                return pos;
+
+            // memchr for the first character, then memcmp for the rest
+            const auto first = data();
+            const auto lastStart = first + (size - needle.size());
+            for (auto it = first + pos; it <= lastStart;)
+            {
+                it = traits_type::find(it, static_cast<size_type>(lastStart - it) + 1, needle.front());
+                if (!it)
+                    return npos;
+
+                if (traits_type::compare(it + 1, needle.data() + 1, needle.size() - 1) == 0)
+                    return static_cast<size_type>(it - first);
+
+                ++it;
+            }
+
+            return npos;
+        }
+
+        int compare(std::string_view other) const noexcept
+        {
+            return view().compare(other);
+        }
+
+        bool starts_with(std::string_view prefix) const noexcept
+        {
+            return size() >= prefix.size() && traits_type::compare(data(), prefix.data(), prefix.size()) == 0;
+        }
+
+        friend bool operator==(const BasicString& lhs, std::string_view rhs) noexcept
+        {
+            return lhs.size() == rhs.size() && traits_type::compare(lhs.data(), rhs.data(), rhs.size()) == 0;
+        }
+
+        friend bool operator!=(const BasicString& lhs, std::string_view rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator==(std::string_view lhs, const BasicString& rhs) noexcept
+        {
+            return rhs == lhs;
+        }
+
+        friend bool operator!=(std::string_view lhs, const BasicString& rhs) noexcept
+        {
+            return !(rhs == lhs);
+        }
+
+        // A string literal converts equally well to std::string_view and to BasicString, so
+        // without these s == "abc" would be ambiguous.
+        friend bool operator==(const BasicString& lhs, const char* rhs) noexcept
+        {
+            return lhs == std::string_view(rhs);
+        }
+
+        friend bool operator!=(const BasicString& lhs, const char* rhs) noexcept
+        {
+            return !(lhs == std::string_view(rhs));
+        }
+
+        friend bool operator==(const char* lhs, const BasicString& rhs) noexcept
+        {
+            return rhs == std::string_view(lhs);
+        }
+
+        friend bool operator!=(const char* lhs, const BasicString& rhs) noexcept
+        {
+            return !(rhs == std::string_view(lhs));
+        }
+
+        friend bool operator==(const BasicString& lhs, const BasicString& rhs) noexcept
+        {
+            return lhs == rhs.view();
+        }
+
+        friend bool operator!=(const BasicString& lhs, const BasicString& rhs) noexcept
+        {
+            return !(lhs == rhs.view());
+        }
+
+        friend bool operator<(const BasicString& lhs, const BasicString& rhs) noexcept
+        {
+            return lhs.compare(rhs.view()) < 0;
+        }
+
+    public:
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        size_type size() const noexcept
+        {
+            return m_impl.size & ~heap_flag;
+        }
+
+        size_type length() const noexcept
+        {
+            return size();
+        }
+
+        size_type capacity() const noexcept
+        {
+            return is_local() ? InlineCapacity : m_impl.storage.heap.capacity;
+        }
+
+        size_type max_size() const noexcept
+        {
+            return std::min<size_type>(heap_flag - 1, std::numeric_limits<difference_type>::max()) - 1;
+        }
+
+        pointer data() noexcept
+        {
+            return is_local() ? m_impl.storage.local : m_impl.storage.heap.data;
+        }
+
+        const_pointer data() const noexcept
+        {
+            return is_local() ? m_impl.storage.local : m_impl.storage.heap.data;
+        }
+
+        const_pointer c_str() const noexcept
+        {
+            return data();
+        }
+
+        std::string_view view() const noexcept
+        {
+            return std::string_view(data(), size());
+        }
+
+        operator std::string_view() const noexcept
+        {
+            return view();
+        }
+
+        iterator begin() noexcept
+        {
+            return iterator{ data() };
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return const_iterator{ data() };
+        }
+
+        iterator end() noexcept
+        {
+            return iterator{ data() + size() };
+        }
+
+        const_iterator end() const noexcept
+        {
+            return const_iterator{ data() + size() };
+        }
+
+        reference operator[](size_type pos) noexcept
+        {
+            return data()[pos];
+        }
+
+        const_reference operator[](size_type pos) const noexcept
+        {
+            return data()[pos];
+        }
+
+        reference at(size_type pos)
+        {
+            if (pos >= size())
+            {
+                throw std::out_of_range("BasicString::at");
+            }
+
+            return data()[pos];
+        }
+
+        const_reference at(size_type pos) const
+        {
+            if (pos >= size())
+            {
+                throw std::out_of_range("BasicString::at");
+            }
+
+            return data()[pos];
+        }
+
+        reference front()
+        {
+            return data()[0];
+        }
+
+        reference back()
+        {
+            return data()[size() - 1];
+        }
+
+        Allocator get_allocator() const noexcept
+        {
+            return allocator();
+        }
+
+    private:
+        static constexpr size_type heap_flag = ~(std::numeric_limits<size_type>::max() >> 1);
+
+        bool is_local() const noexcept
+        {
+            return (m_impl.size & heap_flag) == 0;
+        }
+
+        // Stores the new size and the terminating null character.
+        void set_size(size_type size) noexcept
+        {
+            m_impl.size = size | (m_impl.size & heap_flag);
+            data()[size] = '\0';
+        }
+
+        // Same growth policy as Vector: at least double the current capacity.
+        size_type next_capacity(size_type required) const noexcept
+        {
+            const auto capacity = this->capacity();
+            return std::max(required, capacity + std::max(size_type(1), capacity));
+        }
+
+        void grow_to(size_type required)
+        {
+            if (required > capacity())
+            {
+                if (required > max_size())
+                    throw std::length_error("BasicString::grow");
+
+                reallocate(std::min(next_capacity(required), max_size()));
+            }
+        }
+
+        // Moves the characters into a heap buffer of newCapacity (plus the null terminator).
+        void reallocate(size_type newCapacity)
+        {
+            const auto size = this->size();
+            pointer buffer = Allocator_traits::allocate(allocator(), newCapacity + 1);
+            traits_type::copy(buffer, data(), size + 1);
+
+            release();
+
+            m_impl.storage.heap.data = buffer;
+            m_impl.storage.heap.capacity = newCapacity;
+            m_impl.size = size | heap_flag;
+        }
+
+        void release() noexcept
+        {
+            if (!is_local())
+            {
+                Allocator_traits::deallocate(allocator(), m_impl.storage.heap.data, m_impl.storage.heap.capacity + 1);
+            }
+        }
+
+    private:
+        struct Heap
+        {
+            pointer data;
+            size_type capacity;
+        };
+
+        union Storage
+        {
+            Heap heap;
+            char local[InlineCapacity + 1];
+        };
+
+        // Derives from the allocator so that a stateless one takes no space.
+        struct Impl : Allocator
+        {
+            Impl() = default;
+
+            explicit Impl(const Allocator& allocator)
+                : Allocator(allocator)
+            {
+            }
+
+            Storage storage{};
+            size_type size = 0; // top bit set - heap buffer in use
+        };
+
+        Allocator& allocator() noexcept
+        {
+            return m_impl;
+        }
+
+        const Allocator& allocator() const noexcept
+        {
+            return m_impl;
+        }
+
+    private:
+        Impl m_impl;
+    };
+
+    using String = BasicString<>;
+
+    // Nothing in BasicString points into the object itself, so with a stateless allocator
+    // and raw char pointers it may be moved around with memcpy.
+    template <std::size_t InlineCapacity>
+    struct is_trivially_relocatable<BasicString<InlineCapacity, std::allocator<char>>> : std::true_type
+    {
+    };
+
+} // namespace stl_container_impl
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace stl_container_impl
+{
+    /*---------------------------------------------------------------------------------------------
+     * A type is trivially relocatable if moving an object to a new address and destroying the
+     * original is equivalent to copying its bytes. Containers use this to relocate elements with
+     * memcpy on growth. Trivially copyable types qualify automatically; other types (e.g. ones
+     * holding an owning pointer but no pointer into themselves) opt in by specialization.
+     -----------------------------------------------------------------------------------------------*/
+    template <class T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T>
+    {
+    };
+
+    template <class T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    namespace detail
+    {
+        template <class Allocator, class = void>
+        struct has_member_construct : std::false_type
+        {
+        };
+
+        template <class Allocator>
+        struct has_member_construct<Allocator, std::void_t<decltype(std::declval<Allocator&>().construct(std::declval<typename Allocator::value_type*>()))>> : std::true_type
+        {
+        };
+
+        template <class Allocator, class = void>
+        struct has_member_destroy : std::false_type
+        {
+        };
+
+        template <class Allocator>
+        struct has_member_destroy<Allocator, std::void_t<decltype(std::declval<Allocator&>().destroy(std::declval<typename Allocator::value_type*>()))>> : std::true_type
+        {
+        };
+
+        // True if allocator_traits::construct/destroy fall back to plain construction and destruction,
+        // i.e. elements may be relocated with memcpy behind the allocator's back.
+        template <class Allocator>
+        inline constexpr bool allocator_relocates_trivially =
+            std::is_same<Allocator, std::allocator<typename Allocator::value_type>>::value ||
+            (!has_member_construct<Allocator>::value && !has_member_destroy<Allocator>::value);
+
+    } // namespace detail
+
+} // namespace stl_container_impl
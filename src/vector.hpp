@@ -1,12 +1,25 @@
 #pragma once
 
+#include "config.hpp"
+#include "trivially_relocatable.hpp"
 #include "vector_iterator.hpp"
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <exception>
 #include <limits>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
+#if STL_CONTAINER_IMPL_PERF_COUNTERS
+#include "perf_counters.hpp"
+#define STL_CONTAINER_IMPL_VECTOR_PERF_SCOPE(operation) \
+    const stl_container_impl::perf::Scope perfScope(stl_container_impl::perf::Operation::operation)
+#else
+#define STL_CONTAINER_IMPL_VECTOR_PERF_SCOPE(operation)
+#endif
+
 // TODO: use move_uninitialized instread of move_if_noexcept_uninitialized
 // TODO: can copy_uninitialized be replaced by std::uninitialized_copy?
 
@@ -35,7 +48,7 @@ namespace stl_container_impl
     public:
         Vector() = default;
 
-        Vector(const Vector& other)
+        STL_CONTAINER_IMPL_CONSTEXPR20 Vector(const Vector& other)
         {
             m_allocator = Allocator_traits::select_on_container_copy_construction(other.get_allocator());
 
@@ -59,7 +72,7 @@ namespace stl_container_impl
             m_endOfStorage = m_buffer + newCapacity;
         }
 
-        Vector(Vector&& other) noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 Vector(Vector&& other) noexcept
         {
             /*---------------------------------------------------------------------------------------------
              * Constructs the container with the contents of other using move semantics.
@@ -77,23 +90,25 @@ namespace stl_container_impl
             other.m_endOfStorage = nullptr;
         }
 
-        Vector(std::initializer_list<T> list)
+        STL_CONTAINER_IMPL_CONSTEXPR20 Vector(std::initializer_list<T> list)
         {
             assign(list);
         }
 
-        ~Vector()
+        STL_CONTAINER_IMPL_CONSTEXPR20 ~Vector()
         {
             destroy_range(m_buffer, m_finish);
-            Allocator_traits::deallocate(m_allocator, m_buffer, capacity());
+            deallocate_buffer(m_buffer, capacity());
         }
 
-        void reserve(size_type count)
+        STL_CONTAINER_IMPL_CONSTEXPR20 void reserve(size_type count)
         {
             const auto capacity = this->capacity();
             if (count <= capacity)
                 return;
 
+            STL_CONTAINER_IMPL_VECTOR_PERF_SCOPE(Reserve);
+
             if (count > max_size())
                 throw std::length_error("Vector::reserve");
 
@@ -103,7 +118,7 @@ namespace stl_container_impl
             // Provide strong guarantee
             try
             {
-                move_uninitialized_if_noexcept(m_buffer, m_finish, finish);
+                relocate_uninitialized(m_buffer, m_finish, finish);
             }
             catch (...)
             {
@@ -112,15 +127,17 @@ namespace stl_container_impl
                 throw;
             }
 
-            destroy_range(m_buffer, m_finish);
+            deallocate_buffer(m_buffer, capacity);
 
             m_buffer = buff;
             m_finish = finish;
             m_endOfStorage = m_buffer + count;
         }
 
-        void resize(size_type count)
+        STL_CONTAINER_IMPL_CONSTEXPR20 void resize(size_type count)
         {
+            STL_CONTAINER_IMPL_VECTOR_PERF_SCOPE(Resize);
+
             const auto size = this->size();
             const auto capacity = this->capacity();
             if (count > size)
@@ -140,7 +157,7 @@ namespace stl_container_impl
                         fill_uninitialized(finish, endOfStorage); // default constructed
 
                         destroy_range(m_buffer, m_finish);
-                        Allocator_traits::deallocate(m_allocator, m_buffer, capacity);
+                        deallocate_buffer(m_buffer, capacity);
 
                         m_buffer = newBuff;
                         m_finish = finish;
@@ -158,7 +175,7 @@ namespace stl_container_impl
                     auto finish = m_finish;
                     try
                     {
-                        fill_uninitialized(finish, finish + count);
+                        fill_uninitialized(finish, m_buffer + count);
                         m_finish = finish;
                     }
                     catch (...)
@@ -170,7 +187,7 @@ namespace stl_container_impl
             }
             else
             {
-                auto newFinish = m_buffer + count - size;
+                auto newFinish = m_buffer + count;
 
                 destroy_range(newFinish, m_finish);
                 m_finish = newFinish;
@@ -179,7 +196,7 @@ namespace stl_container_impl
 
         // TODO: Check if InputIt is LegacyInputIterator
         template <typename InputIt>
-        void assign(InputIt first, InputIt last)
+        STL_CONTAINER_IMPL_CONSTEXPR20 void assign(InputIt first, InputIt last)
         {
             clear();
             for (; first != last; ++first)
@@ -188,13 +205,13 @@ namespace stl_container_impl
             }
         }
 
-        void assign(std::initializer_list<T> ilist)
+        STL_CONTAINER_IMPL_CONSTEXPR20 void assign(std::initializer_list<T> ilist)
         {
             assign(ilist.begin(), ilist.end());
         }
 
         template <typename... Args>
-        void emplace_back(Args&&... args)
+        STL_CONTAINER_IMPL_CONSTEXPR20 void emplace_back(Args&&... args)
         {
             if (m_finish != m_endOfStorage)
             {
@@ -207,7 +224,7 @@ namespace stl_container_impl
             }
         }
 
-        void push_back(const T& value)
+        STL_CONTAINER_IMPL_CONSTEXPR20 void push_back(const T& value)
         {
             if (m_finish != m_endOfStorage)
             {
@@ -220,13 +237,89 @@ namespace stl_container_impl
             }
         }
 
-        void push_back(value_type&& value)
+        STL_CONTAINER_IMPL_CONSTEXPR20 void push_back(value_type&& value)
         {
             emplace_back(std::move(value));
         }
 
-        iterator insert(const_iterator pos, size_type count, const_reference value)
+        /*---------------------------------------------------------------------------------------------
+         * Scoped appender returned by reserve_append(n).
+         *
+         * Keeps the write position in a local pointer, so emplace() is a bare construction without
+         * a capacity check or a reallocation path, and loops over trivially copyable T vectorize.
+         * At most n elements may be emplaced; this is not checked. The vector must not be touched
+         * while the appender is alive.
+         *
+         * The destructor commits the appended elements to the vector. If it runs because an
+         * exception is propagating (e.g. an element constructor threw), the elements appended
+         * through this appender are destroyed instead and the vector keeps its old size.
+         -----------------------------------------------------------------------------------------------*/
+        class BackAppender
+        {
+        public:
+            BackAppender(const BackAppender&) = delete;
+            BackAppender& operator=(const BackAppender&) = delete;
+
+            ~BackAppender()
+            {
+                if (std::uncaught_exceptions() > m_uncaughtExceptions)
+                {
+                    m_owner.destroy_range(m_owner.m_finish, m_finish);
+                    return;
+                }
+
+                m_owner.m_finish = m_finish;
+            }
+
+            template <typename... Args>
+            reference emplace(Args&&... args)
+            {
+                Allocator_traits::construct(m_owner.m_allocator, m_finish, std::forward<Args>(args)...);
+                return *m_finish++;
+            }
+
+            // Number of elements appended so far.
+            size_type size() const noexcept
+            {
+                return m_finish - m_owner.m_finish;
+            }
+
+        private:
+            friend class Vector;
+
+            explicit BackAppender(Vector& owner) noexcept
+                : m_owner(owner)
+                , m_finish(owner.m_finish)
+                , m_uncaughtExceptions(std::uncaught_exceptions())
+            {
+            }
+
+        private:
+            Vector& m_owner;
+            pointer m_finish;
+            int m_uncaughtExceptions;
+        };
+
+        // Makes room for count more elements and returns an appender for them.
+        // Capacity grows geometrically, so repeated calls with small counts stay amortized O(1).
+        BackAppender reserve_append(size_type count)
+        {
+            const auto size = this->size();
+            if (count > max_size() - size)
+                throw std::length_error("Vector::reserve_append");
+
+            if (size + count > capacity())
+            {
+                reserve(std::max(size + count, 2 * capacity()));
+            }
+
+            return BackAppender{ *this };
+        }
+
+        STL_CONTAINER_IMPL_CONSTEXPR20 iterator insert(const_iterator pos, size_type count, const_reference value)
         {
+            STL_CONTAINER_IMPL_VECTOR_PERF_SCOPE(Insert);
+
             auto ptr = m_buffer + (pos.base() - m_buffer);
             const auto oldCapacity = capacity();
             const auto newSize = size() + count;
@@ -268,7 +361,7 @@ namespace stl_container_impl
 
                 move_uninitialized_if_noexcept(ptr, m_finish, finish);
                 destroy_range(m_buffer, m_finish);
-                Allocator_traits::deallocate(m_allocator, m_buffer, oldCapacity);
+                deallocate_buffer(m_buffer, oldCapacity);
 
                 m_buffer = buffer;
                 m_finish = finish;
@@ -284,19 +377,21 @@ namespace stl_container_impl
             }
         }
 
-        iterator insert(const_iterator pos, const_reference value)
+        STL_CONTAINER_IMPL_CONSTEXPR20 iterator insert(const_iterator pos, const_reference value)
         {
             return insert(pos, 1, value);
         }
 
-        void pop_back() noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 void pop_back() noexcept
         {
             --m_finish;
             Allocator_traits::destroy(m_allocator, m_finish);
         }
 
-        iterator erase(iterator pos) noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 iterator erase(iterator pos) noexcept
         {
+            STL_CONTAINER_IMPL_VECTOR_PERF_SCOPE(Erase);
+
             auto dest = pos.base();
             auto src = dest + 1;
 
@@ -309,43 +404,64 @@ namespace stl_container_impl
             return iterator{ dest };
         }
 
-        void shrink_to_fit() noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 void shrink_to_fit()
+        {
+            shrink_to(size());
+        }
+
+        // Reduces capacity to max(count, size()); does nothing if that is not below capacity().
+        // Provides strong guarantee.
+        STL_CONTAINER_IMPL_CONSTEXPR20 void shrink_to(size_type count)
         {
-            const auto size = this->size();
             const auto capacity = this->capacity();
+            const auto newCapacity = std::max(count, size());
 
-            if (size == capacity)
+            if (newCapacity >= capacity)
             {
                 return;
             }
 
-            pointer buffer = Allocator_traits::allocate(m_allocator, size);
+            STL_CONTAINER_IMPL_VECTOR_PERF_SCOPE(ShrinkToFit);
+
+            if (newCapacity == 0)
+            {
+                deallocate_buffer(m_buffer, capacity);
+
+                m_buffer = nullptr;
+                m_finish = nullptr;
+                m_endOfStorage = nullptr;
+                return;
+            }
+
+            pointer buffer = Allocator_traits::allocate(m_allocator, newCapacity);
             pointer finish = buffer;
 
             try
             {
-                move_uninitialized_if_noexcept(m_buffer, m_finish, finish);
-
-                m_buffer = buffer;
-                m_finish = finish;
-                m_endOfStorage = m_finish;
+                relocate_uninitialized(m_buffer, m_finish, finish);
             }
             catch (...)
             {
                 destroy_range(buffer, finish);
-                Allocator_traits::deallocate(m_allocator, buffer, size);
+                Allocator_traits::deallocate(m_allocator, buffer, newCapacity);
                 throw;
             }
+
+            deallocate_buffer(m_buffer, capacity);
+
+            m_buffer = buffer;
+            m_finish = finish;
+            m_endOfStorage = m_buffer + newCapacity;
         }
 
-        void clear() noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 void clear() noexcept
         {
             destroy_range(m_buffer, m_finish);
             m_finish = m_buffer;
         }
 
     public:
-        Vector& operator=(const Vector& other)
+        STL_CONTAINER_IMPL_CONSTEXPR20 Vector& operator=(const Vector& other)
         {
             if (std::addressof(other) == this) // operator& can be overloaded
             {
@@ -380,7 +496,7 @@ namespace stl_container_impl
                 }
 
                 destroy_range(m_buffer, m_finish);
-                Allocator_traits::deallocate(m_allocator, m_buffer, oldCap);
+                deallocate_buffer(m_buffer, oldCap);
 
                 m_buffer = newBuff;
                 m_finish = m_buffer + newSize;
@@ -409,7 +525,7 @@ namespace stl_container_impl
             return *this;
         }
 
-        Vector& operator=(Vector&& other) noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 Vector& operator=(Vector&& other) noexcept
         {
             if (std::addressof(other) == this) // operator& can be overloaded
             {
@@ -434,10 +550,8 @@ namespace stl_container_impl
 
             if (m_allocator == other.m_allocator)
             {
-                destroy_range(m_buffer, m_finish);
-                Allocator_traits::deallocate(m_allocator, m_buffer, capacity());
-
-                new (this) Vector(std::move(other));
+                std::destroy_at(this);
+                detail::construct_at(this, std::move(other));
             }
             else
             {
@@ -449,7 +563,7 @@ namespace stl_container_impl
                 if (newSize > oldCapacity)
                 {
                     destroy_range(m_buffer, m_finish);
-                    Allocator_traits::deallocate(m_allocator, m_buffer, oldCapacity);
+                    deallocate_buffer(m_buffer, oldCapacity);
 
                     m_finish = m_buffer = Allocator_traits::allocate(m_allocator, newCapacity);
                     move_uninitialized_if_noexcept(other.m_buffer, other.m_finish, m_finish);
@@ -476,87 +590,87 @@ namespace stl_container_impl
         }
 
     public:
-        bool empty() const noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 bool empty() const noexcept
         {
             return m_buffer == m_finish;
         }
 
-        size_type max_size() const noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 size_type max_size() const noexcept
         {
             return std::numeric_limits<difference_type>::max();
         }
 
-        size_type size() const noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 size_type size() const noexcept
         {
             return m_finish - m_buffer;
         }
 
-        size_type capacity() const noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 size_type capacity() const noexcept
         {
             return m_endOfStorage - m_buffer;
         }
 
-        iterator begin() noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 iterator begin() noexcept
         {
             return iterator{ m_buffer };
         }
 
-        const_iterator cbegin() const noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 const_iterator cbegin() const noexcept
         {
             return const_iterator{ m_buffer };
         }
 
-        iterator end() noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 iterator end() noexcept
         {
             return iterator{ m_finish };
         }
 
-        const_iterator cend() const noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 const_iterator cend() const noexcept
         {
             return const_iterator{ m_finish };
         }
 
-        Allocator get_allocator() const noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 Allocator get_allocator() const noexcept
         {
             return m_allocator;
         }
 
-        reference front()
+        STL_CONTAINER_IMPL_CONSTEXPR20 reference front()
         {
             return *m_buffer;
         }
 
-        const_reference front() const
+        STL_CONTAINER_IMPL_CONSTEXPR20 const_reference front() const
         {
             return *m_buffer;
         }
 
-        reference back()
+        STL_CONTAINER_IMPL_CONSTEXPR20 reference back()
         {
             return *(m_finish - 1);
         }
 
-        const_reference back() const
+        STL_CONTAINER_IMPL_CONSTEXPR20 const_reference back() const
         {
             return *(m_finish - 1);
         }
 
-        pointer data() noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 pointer data() noexcept
         {
             return m_buffer;
         }
 
-        const_pointer data() const noexcept
+        STL_CONTAINER_IMPL_CONSTEXPR20 const_pointer data() const noexcept
         {
             return m_buffer;
         };
 
-        reference operator[](size_type pos)
+        STL_CONTAINER_IMPL_CONSTEXPR20 reference operator[](size_type pos)
         {
             return m_buffer[pos];
         }
 
-        reference at(size_type pos)
+        STL_CONTAINER_IMPL_CONSTEXPR20 reference at(size_type pos)
         {
             if (pos >= size())
             {
@@ -566,7 +680,7 @@ namespace stl_container_impl
             return m_buffer[pos];
         }
 
-        const_reference at(size_type pos) const
+        STL_CONTAINER_IMPL_CONSTEXPR20 const_reference at(size_type pos) const
         {
             if (pos >= size())
             {
@@ -578,15 +692,20 @@ namespace stl_container_impl
 
     private:
         template <typename... Args>
-        void reallocate_and_insert_back_strong(Args&&... args);
+        STL_CONTAINER_IMPL_CONSTEXPR20 void reallocate_and_insert_back_strong(Args&&... args);
 
         template <typename... Args>
-        void fill_uninitialized(pointer& first, pointer last, Args&... args);
-        void move_uninitialized_if_noexcept(pointer fromFirst, pointer fromLast, pointer& to);
-        void copy_uninitialized(pointer srcFirst, pointer srcLast, pointer& dst);
-
-        void move_backwards(pointer first, pointer last, pointer dst);
-        void destroy_range(pointer first, pointer last);
+        STL_CONTAINER_IMPL_CONSTEXPR20 void fill_uninitialized(pointer& first, pointer last, Args&... args);
+        STL_CONTAINER_IMPL_CONSTEXPR20 void move_uninitialized_if_noexcept(pointer fromFirst, pointer fromLast, pointer& to);
+        // Moves [fromFirst, fromLast) to uninitialized memory at to and destroys the originals.
+        // If an element's move throws, the originals are left intact.
+        STL_CONTAINER_IMPL_CONSTEXPR20 void relocate_uninitialized(pointer fromFirst, pointer fromLast, pointer& to);
+        STL_CONTAINER_IMPL_CONSTEXPR20 void copy_uninitialized(pointer srcFirst, pointer srcLast, pointer& dst);
+
+        STL_CONTAINER_IMPL_CONSTEXPR20 void move_backwards(pointer first, pointer last, pointer dst);
+        STL_CONTAINER_IMPL_CONSTEXPR20 void destroy_range(pointer first, pointer last);
+        // Null-safe: constant evaluation rejects deallocating a null pointer.
+        STL_CONTAINER_IMPL_CONSTEXPR20 void deallocate_buffer(pointer buffer, size_type capacity);
 
     private:
         pointer m_buffer = nullptr;
@@ -603,37 +722,73 @@ namespace stl_container_impl
 {
     template <typename T, typename Allocator>
     template <typename... Args>
-    void Vector<T, Allocator>::reallocate_and_insert_back_strong(Args&&... args)
+    STL_CONTAINER_IMPL_CONSTEXPR20 void Vector<T, Allocator>::reallocate_and_insert_back_strong(Args&&... args)
     {
+        STL_CONTAINER_IMPL_VECTOR_PERF_SCOPE(Reallocate);
+
         const auto oldSize = size();
         const auto oldCap = capacity();
         const auto newCapacity = oldCap + std::max(size_type(1), oldCap);
         pointer buff = Allocator_traits::allocate(m_allocator, newCapacity);
         pointer finish = buff;
 
+        // The new element is constructed first: args may refer to an element of this vector,
+        // which must not be relocated yet.
         try
         {
-            move_uninitialized_if_noexcept(m_buffer, m_finish, finish);
             Allocator_traits::construct(m_allocator, buff + oldSize, std::forward<Args>(args)...);
-            ++finish;
-
-            destroy_range(m_buffer, m_finish);
-            Allocator_traits::deallocate(m_allocator, m_buffer, capacity());
+        }
+        catch (...)
+        {
+            Allocator_traits::deallocate(m_allocator, buff, newCapacity);
+            throw;
+        }
 
-            m_buffer = buff;
-            m_endOfStorage = m_buffer + newCapacity;
-            m_finish = finish;
+        try
+        {
+            relocate_uninitialized(m_buffer, m_finish, finish);
         }
         catch (...)
         {
             destroy_range(buff, finish);
+            Allocator_traits::destroy(m_allocator, buff + oldSize);
             Allocator_traits::deallocate(m_allocator, buff, newCapacity);
             throw;
         }
+
+        ++finish;
+        deallocate_buffer(m_buffer, oldCap);
+
+        m_buffer = buff;
+        m_endOfStorage = m_buffer + newCapacity;
+        m_finish = finish;
     }
 
     template <typename T, typename Allocator>
-    void Vector<T, Allocator>::move_uninitialized_if_noexcept(typename Vector<T, Allocator>::pointer fromFirst, typename Vector<T, Allocator>::pointer fromLast, typename Vector<T, Allocator>::pointer& to)
+    STL_CONTAINER_IMPL_CONSTEXPR20 void Vector<T, Allocator>::relocate_uninitialized(typename Vector<T, Allocator>::pointer fromFirst, typename Vector<T, Allocator>::pointer fromLast, typename Vector<T, Allocator>::pointer& to)
+    {
+        // memcpy is only valid when the allocator does not customize construct/destroy,
+        // and it cannot be used in constant expressions
+        if constexpr (is_trivially_relocatable_v<T> && detail::allocator_relocates_trivially<Allocator>)
+        {
+            if (!detail::is_constant_evaluated())
+            {
+                const auto count = static_cast<size_type>(fromLast - fromFirst);
+                if (count != 0)
+                {
+                    std::memcpy(static_cast<void*>(to), static_cast<const void*>(fromFirst), count * sizeof(T));
+                }
+                to += count;
+                return;
+            }
+        }
+
+        move_uninitialized_if_noexcept(fromFirst, fromLast, to);
+        destroy_range(fromFirst, fromLast);
+    }
+
+    template <typename T, typename Allocator>
+    STL_CONTAINER_IMPL_CONSTEXPR20 void Vector<T, Allocator>::move_uninitialized_if_noexcept(typename Vector<T, Allocator>::pointer fromFirst, typename Vector<T, Allocator>::pointer fromLast, typename Vector<T, Allocator>::pointer& to)
     {
         for (; fromFirst != fromLast; ++fromFirst, ++to)
         {
@@ -643,7 +798,7 @@ namespace stl_container_impl
 
     template <typename T, typename Allocator>
     template <typename... Args>
-    void Vector<T, Allocator>::fill_uninitialized(pointer& first, pointer last, Args&... args)
+    STL_CONTAINER_IMPL_CONSTEXPR20 void Vector<T, Allocator>::fill_uninitialized(pointer& first, pointer last, Args&... args)
     {
         for (; first != last; ++first)
         {
@@ -652,7 +807,7 @@ namespace stl_container_impl
     }
 
     template <typename T, typename Allocator>
-    void Vector<T, Allocator>::copy_uninitialized(typename Vector<T, Allocator>::pointer srcFirst, typename Vector<T, Allocator>::pointer srcLast, typename Vector<T, Allocator>::pointer& dst)
+    STL_CONTAINER_IMPL_CONSTEXPR20 void Vector<T, Allocator>::copy_uninitialized(typename Vector<T, Allocator>::pointer srcFirst, typename Vector<T, Allocator>::pointer srcLast, typename Vector<T, Allocator>::pointer& dst)
     {
         for (; srcFirst != srcLast; ++srcFirst, ++dst)
         {
@@ -661,7 +816,7 @@ namespace stl_container_impl
     }
 
     template <typename T, typename Allocator>
-    void Vector<T, Allocator>::move_backwards(typename Vector<T, Allocator>::pointer first, typename Vector<T, Allocator>::pointer last, typename Vector<T, Allocator>::pointer dst)
+    STL_CONTAINER_IMPL_CONSTEXPR20 void Vector<T, Allocator>::move_backwards(typename Vector<T, Allocator>::pointer first, typename Vector<T, Allocator>::pointer last, typename Vector<T, Allocator>::pointer dst)
     {
         while (first != last)
         {
@@ -670,7 +825,7 @@ namespace stl_container_impl
     }
 
     template <typename T, typename Allocator>
-    void Vector<T, Allocator>::destroy_range(typename Vector<T, Allocator>::pointer first, typename Vector<T, Allocator>::pointer last)
+    STL_CONTAINER_IMPL_CONSTEXPR20 void Vector<T, Allocator>::destroy_range(typename Vector<T, Allocator>::pointer first, typename Vector<T, Allocator>::pointer last)
     {
         for (auto ptr = first; ptr != last; ++ptr)
         {
@@ -678,4 +833,13 @@ namespace stl_container_impl
         }
     }
 
+    template <typename T, typename Allocator>
+    STL_CONTAINER_IMPL_CONSTEXPR20 void Vector<T, Allocator>::deallocate_buffer(typename Vector<T, Allocator>::pointer buffer, typename Vector<T, Allocator>::size_type capacity)
+    {
+        if (buffer)
+        {
+            Allocator_traits::deallocate(m_allocator, buffer, capacity);
+        }
+    }
+
 } // namespace stl_container_impl
@@ -25,88 +25,108 @@ namespace stl_container_impl
         using reference = typename traits_type::reference;
         using pointer = typename traits_type::pointer;
 
-        pointer_wrapper_iterator() noexcept
+        constexpr pointer_wrapper_iterator() noexcept
             : m_ptr(Iterator())
         {
         }
 
-        explicit pointer_wrapper_iterator(const Iterator& i) noexcept
+        constexpr explicit pointer_wrapper_iterator(const Iterator& i) noexcept
             : m_ptr(i)
         {
         }
 
         template <typename Iter, typename = convertible_from<Iter>>
-        pointer_wrapper_iterator(const pointer_wrapper_iterator<Iter, Container>& i) noexcept
+        constexpr pointer_wrapper_iterator(const pointer_wrapper_iterator<Iter, Container>& i) noexcept
             : m_ptr(i.base())
         {
         }
 
         // Forward iterator requirements
-        reference operator*() const noexcept
+        constexpr reference operator*() const noexcept
         {
             return *m_ptr;
         }
-        pointer operator->() const noexcept
+        constexpr pointer operator->() const noexcept
         {
             return m_ptr;
         }
 
-        pointer_wrapper_iterator& operator++() noexcept
+        constexpr pointer_wrapper_iterator& operator++() noexcept
         {
             ++m_ptr;
             return *this;
         }
 
-        pointer_wrapper_iterator operator++(int) noexcept
+        constexpr pointer_wrapper_iterator operator++(int) noexcept
         {
             return pointer_wrapper_iterator(m_ptr++);
         }
 
-        bool operator!=(const pointer_wrapper_iterator& other) const noexcept
+        constexpr bool operator!=(const pointer_wrapper_iterator& other) const noexcept
         {
             return m_ptr != other.m_ptr;
         }
-        bool operator==(const pointer_wrapper_iterator& other) const noexcept
+        constexpr bool operator==(const pointer_wrapper_iterator& other) const noexcept
         {
             return m_ptr == other.m_ptr;
         }
 
         // Bidirectional iterator requirements
-        pointer_wrapper_iterator& operator--() noexcept
+        constexpr pointer_wrapper_iterator& operator--() noexcept
         {
             --m_ptr;
             return *this;
         }
 
-        pointer_wrapper_iterator operator--(int) noexcept
+        constexpr pointer_wrapper_iterator operator--(int) noexcept
         {
             return pointer_wrapper_iterator(m_ptr--);
         }
 
         // Random access iterator requirements
-        reference operator[](difference_type n) const noexcept
+        constexpr reference operator[](difference_type n) const noexcept
         {
             return m_ptr[n];
         }
-        pointer_wrapper_iterator& operator+=(difference_type n) noexcept
+        constexpr pointer_wrapper_iterator& operator+=(difference_type n) noexcept
         {
             m_ptr += n;
             return *this;
         }
-        pointer_wrapper_iterator operator+(difference_type n) const noexcept
+        constexpr pointer_wrapper_iterator operator+(difference_type n) const noexcept
         {
             return pointer_wrapper_iterator(m_ptr + n);
         }
-        pointer_wrapper_iterator& operator-=(difference_type n) noexcept
+        constexpr pointer_wrapper_iterator& operator-=(difference_type n) noexcept
         {
             m_ptr -= n;
             return *this;
         }
-        pointer_wrapper_iterator operator-(difference_type n) const noexcept
+        constexpr pointer_wrapper_iterator operator-(difference_type n) const noexcept
         {
             return pointer_wrapper_iterator(m_ptr - n);
         }
-        const Iterator& base() const noexcept
+        constexpr difference_type operator-(const pointer_wrapper_iterator& other) const noexcept
+        {
+            return m_ptr - other.m_ptr;
+        }
+        constexpr bool operator<(const pointer_wrapper_iterator& other) const noexcept
+        {
+            return m_ptr < other.m_ptr;
+        }
+        constexpr bool operator>(const pointer_wrapper_iterator& other) const noexcept
+        {
+            return m_ptr > other.m_ptr;
+        }
+        constexpr bool operator<=(const pointer_wrapper_iterator& other) const noexcept
+        {
+            return m_ptr <= other.m_ptr;
+        }
+        constexpr bool operator>=(const pointer_wrapper_iterator& other) const noexcept
+        {
+            return m_ptr >= other.m_ptr;
+        }
+        constexpr const Iterator& base() const noexcept
         {
             return m_ptr;
         }
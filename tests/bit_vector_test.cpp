@@ -0,0 +1,202 @@
+#include "test.hpp"
+#include "bit_vector.hpp"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using BitVector = stl_container_impl::BitVector<>;
+
+namespace
+{
+    bool matches(const BitVector& actual, const std::vector<bool>& expected)
+    {
+        if (actual.size() != expected.size())
+            return false;
+
+        std::size_t count = 0;
+        for (std::size_t i = 0; i != expected.size(); ++i)
+        {
+            if (actual[i] != expected[i])
+                return false;
+            count += expected[i];
+        }
+
+        if (actual.count() != count || actual.all() != (count == expected.size()) || actual.any() != (count != 0))
+            return false;
+
+        // find_first/find_next visit exactly the set bits, in order
+        auto pos = actual.find_first();
+        for (std::size_t i = 0; i != expected.size(); ++i)
+        {
+            if (!expected[i])
+                continue;
+            if (pos != i)
+                return false;
+            pos = actual.find_next(pos);
+        }
+
+        return pos == BitVector::npos;
+    }
+
+    BitVector from(const std::vector<bool>& bits)
+    {
+        BitVector result;
+        for (const bool bit : bits)
+            result.push_back(bit);
+        return result;
+    }
+
+} // namespace
+
+// Random edits around word boundaries, checked against std::vector<bool> after every step.
+STL_CONTAINER_IMPL_TEST(bit_vector_matches_reference_model)
+{
+    std::mt19937 rng(6);
+    BitVector actual;
+    std::vector<bool> expected;
+
+    for (int step = 0; step != 5000; ++step)
+    {
+        const auto op = rng() % 10;
+        if (op < 3)
+        {
+            const bool value = rng() % 2;
+            actual.push_back(value);
+            expected.push_back(value);
+        }
+        else if (op == 3 && !expected.empty())
+        {
+            actual.pop_back();
+            expected.pop_back();
+        }
+        else if (op == 4)
+        {
+            // Just below, at or just past a word boundary
+            const auto count = (rng() % 4) * 64 + 63 + rng() % 3;
+            const bool value = rng() % 2;
+            actual.resize(count, value);
+            expected.resize(count, value);
+        }
+        else if (op == 5 && !expected.empty())
+        {
+            auto first = rng() % (expected.size() + 1);
+            auto last = rng() % (expected.size() + 1);
+            if (first > last)
+                std::swap(first, last);
+
+            const bool value = rng() % 2;
+            if (value)
+                actual.set(first, last);
+            else
+                actual.reset(first, last);
+            for (auto i = first; i != last; ++i)
+                expected[i] = value;
+        }
+        else if (op == 6 && !expected.empty())
+        {
+            const auto pos = rng() % expected.size();
+            actual.flip(pos);
+            expected[pos] = !expected[pos];
+        }
+        else if (op == 7 && !expected.empty())
+        {
+            const auto pos = rng() % expected.size();
+            actual[pos] = !actual[pos];
+            expected[pos] = !expected[pos];
+        }
+        else if (op == 8 && rng() % 8 == 0)
+        {
+            actual.set();
+            expected.assign(expected.size(), true);
+        }
+
+        CHECK(matches(actual, expected));
+    }
+}
+
+// resize(n, true) followed by a shrink must not leave set bits past size().
+STL_CONTAINER_IMPL_TEST(bit_vector_shrink_clears_tail)
+{
+    BitVector bits;
+    bits.resize(130, true);
+    CHECK(bits.count() == 130);
+    CHECK(bits.all());
+
+    bits.resize(70);
+    CHECK(bits.count() == 70);
+    CHECK(bits.all());
+    CHECK(bits.word_count() == 2);
+    CHECK(bits.words()[1] == (1u << 6) - 1);
+
+    bits.resize(100);
+    CHECK(bits.count() == 70);
+    CHECK(bits.find_next(69) == BitVector::npos);
+    CHECK(bits != from(std::vector<bool>(70, true)));
+
+    std::vector<bool> expected(70, true);
+    expected.resize(100, false);
+    CHECK(bits == from(expected));
+
+    while (bits.size() > 64)
+        bits.pop_back();
+    CHECK(bits.word_count() == 1);
+    CHECK(bits.count() == 64);
+    bits.pop_back();
+    CHECK(bits.count() == 63);
+    CHECK(bits.all());
+    bits.push_back(false);
+    CHECK(!bits.all());
+}
+
+STL_CONTAINER_IMPL_TEST(bit_vector_bulk_operators)
+{
+    std::mt19937 rng(8);
+    for (const std::size_t size : { std::size_t(0), std::size_t(1), std::size_t(63), std::size_t(64), std::size_t(65), std::size_t(300) })
+    {
+        std::vector<bool> a;
+        std::vector<bool> b;
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            a.push_back(rng() % 2);
+            b.push_back(rng() % 3 == 0);
+        }
+
+        std::vector<bool> expectedAnd(size), expectedOr(size), expectedXor(size), expectedAndNot(size);
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            expectedAnd[i] = a[i] && b[i];
+            expectedOr[i] = a[i] || b[i];
+            expectedXor[i] = a[i] != b[i];
+            expectedAndNot[i] = a[i] && !b[i];
+        }
+
+        const auto lhs = from(a);
+        const auto rhs = from(b);
+
+        auto result = lhs;
+        CHECK(matches(result &= rhs, expectedAnd));
+        result = lhs;
+        CHECK(matches(result |= rhs, expectedOr));
+        result = lhs;
+        CHECK(matches(result ^= rhs, expectedXor));
+        result = lhs;
+        CHECK(matches(result.and_not(rhs), expectedAndNot));
+
+        CHECK(lhs == from(a));
+        CHECK((lhs != rhs) == (a != b));
+    }
+
+    BitVector shorter(10);
+    BitVector longer(11);
+    bool threw = false;
+    try
+    {
+        shorter |= longer;
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    CHECK(threw);
+}
@@ -0,0 +1,149 @@
+#include "test.hpp"
+#include "gap_vector.hpp"
+#include "ring_buffer.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using stl_container_impl::GapVector;
+using stl_container_impl::RingBuffer;
+
+namespace
+{
+    template <typename T>
+    bool equals(const GapVector<T>& actual, const std::vector<T>& expected)
+    {
+        if (actual.size() != expected.size())
+            return false;
+
+        for (std::size_t i = 0; i != expected.size(); ++i)
+        {
+            if (actual[i] != expected[i])
+                return false;
+        }
+
+        return std::equal(actual.begin(), actual.end(), expected.begin());
+    }
+
+} // namespace
+
+// Random edits clustered around a moving cursor, checked against std::vector.
+STL_CONTAINER_IMPL_TEST(gap_vector_matches_reference_model)
+{
+    std::mt19937 rng(1);
+    GapVector<std::string> actual;
+    std::vector<std::string> expected;
+
+    std::size_t cursor = 0;
+    for (int step = 0; step != 20000; ++step)
+    {
+        if (rng() % 16 == 0)
+            cursor = expected.empty() ? 0 : rng() % (expected.size() + 1);
+        cursor = std::min(cursor, expected.size());
+
+        const auto op = rng() % 8;
+        if (op < 4)
+        {
+            auto value = std::to_string(step) + std::string(rng() % 24, 'x');
+            actual.insert(cursor, value);
+            expected.insert(expected.begin() + cursor, value);
+            ++cursor;
+        }
+        else if (op < 6 && cursor != 0)
+        {
+            --cursor;
+            actual.erase(cursor);
+            expected.erase(expected.begin() + cursor);
+        }
+        else if (op == 6)
+        {
+            actual.push_back("back");
+            expected.push_back("back");
+        }
+        else if (!expected.empty())
+        {
+            const auto first = rng() % expected.size();
+            const auto count = std::min<std::size_t>(rng() % 4, expected.size() - first);
+            actual.erase(first, count);
+            expected.erase(expected.begin() + first, expected.begin() + first + count);
+        }
+
+        if (step % 1000 == 0)
+            CHECK(equals(actual, expected));
+    }
+
+    CHECK(equals(actual, expected));
+
+    const auto [before, after] = actual.segments();
+    CHECK(before.size() + after.size() == expected.size());
+
+    GapVector<std::string> copy = actual;
+    CHECK(equals(copy, expected));
+}
+
+// Inserting an element of the container itself must copy it before the gap moves or the
+// buffer is reallocated.
+STL_CONTAINER_IMPL_TEST(gap_vector_insert_of_own_element)
+{
+    const std::string a(40, 'a');
+    const std::string b(40, 'b');
+    const std::string c(40, 'c');
+
+    GapVector<std::string> moveGap{ a, b, c };
+    moveGap.reserve(8);
+    moveGap.insert(0, moveGap[1]); // gap moves from the end to 0 across b
+    CHECK(equals(moveGap, std::vector<std::string>{ b, a, b, c }));
+
+    moveGap.insert(4, moveGap[0]); // gap moves back to the end
+    CHECK(equals(moveGap, std::vector<std::string>{ b, a, b, c, b }));
+
+    GapVector<std::string> full{ a, b, c };
+    full.reserve(3);
+    CHECK(full.size() == full.capacity());
+    full.insert(1, full[2]); // reallocation
+    CHECK(equals(full, std::vector<std::string>{ a, c, b, c }));
+
+    GapVector<std::string> atGap{ a, b };
+    atGap.reserve(4);
+    atGap.insert(2, atGap[0]); // gap already at the insert position
+    CHECK(equals(atGap, std::vector<std::string>{ a, b, a }));
+
+    atGap.emplace_back(atGap.front());
+    CHECK(equals(atGap, std::vector<std::string>{ a, b, a, a }));
+}
+
+// index_iterator (shared with RingBuffer) meets the random access requirements, including
+// n + it and comparisons between iterator and const_iterator in both orders.
+STL_CONTAINER_IMPL_TEST(gap_vector_iterators_are_random_access)
+{
+    GapVector<int> values;
+    for (int i = 0; i != 10; ++i)
+        values.push_back(9 - i);
+    values.insert(5, 100); // gap in the middle
+
+    const GapVector<int>& constValues = values;
+    const auto it = values.begin();
+    const auto cit = constValues.begin();
+
+    CHECK(*(2 + it) == 7);
+    CHECK(2 + it == it + 2);
+    CHECK(*(3 + cit) == 6);
+
+    CHECK(it == cit && cit == it);
+    CHECK(!(it != cit) && !(cit != it));
+    CHECK(it + 1 > cit && cit < it + 1);
+    CHECK(it <= cit && cit >= it);
+    CHECK(values.end() - cit == 11 && constValues.end() - it == 11);
+
+    std::sort(values.begin(), values.end());
+    CHECK(std::is_sorted(constValues.begin(), constValues.end()));
+    CHECK(values[0] == 0 && values[10] == 100);
+
+    RingBuffer<int> ring{ 1, 2, 3 };
+    const RingBuffer<int>& constRing = ring;
+    CHECK(*(1 + ring.begin()) == 2);
+    CHECK(constRing.end() - ring.begin() == 3);
+    CHECK(ring.begin() < constRing.end() && constRing.begin() < ring.end());
+}
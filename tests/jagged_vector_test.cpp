@@ -0,0 +1,138 @@
+#include "test.hpp"
+#include "jagged_vector.hpp"
+
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using stl_container_impl::JaggedVector;
+
+namespace
+{
+    bool row_equals(const JaggedVector<std::string>& jagged, std::size_t pos, const std::vector<std::string>& expected)
+    {
+        const auto row = jagged.row(pos);
+        return row.size() == expected.size() && std::equal(row.begin(), row.end(), expected.begin());
+    }
+
+    // Forward iterator that throws when dereferenced at position throwAt.
+    struct ThrowingIterator
+    {
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string*;
+        using reference = std::string;
+
+        int pos;
+        int throwAt;
+
+        std::string operator*() const
+        {
+            if (pos == throwAt)
+                throw std::runtime_error("ThrowingIterator");
+            return std::string(40, 'x');
+        }
+
+        ThrowingIterator& operator++()
+        {
+            ++pos;
+            return *this;
+        }
+
+        ThrowingIterator operator++(int)
+        {
+            auto copy = *this;
+            ++pos;
+            return copy;
+        }
+
+        bool operator==(const ThrowingIterator& other) const
+        {
+            return pos == other.pos;
+        }
+
+        bool operator!=(const ThrowingIterator& other) const
+        {
+            return pos != other.pos;
+        }
+    };
+
+} // namespace
+
+// Appending a row of the container to itself must survive the reallocation of the elements.
+STL_CONTAINER_IMPL_TEST(jagged_vector_append_own_row)
+{
+    const std::vector<std::string> first{ std::string(40, 'a'), std::string(40, 'b'), std::string(40, 'c') };
+
+    JaggedVector<std::string> jagged;
+    jagged.append_row(first.begin(), first.end());
+    CHECK(jagged.size() == jagged.values().size());
+
+    const JaggedVector<std::string>& constJagged = jagged;
+    jagged.append_row(constJagged.row(0)); // const_row_type overload
+    CHECK(row_equals(jagged, 1, first));
+
+    const auto row = jagged.row(1);
+    jagged.append_row(row.begin(), row.end()); // Span iterators
+    CHECK(row_equals(jagged, 2, first));
+
+    const auto values = jagged.values();
+    jagged.append_row(values.data() + 1, values.data() + 2); // raw pointers
+    CHECK(row_equals(jagged, 3, { first[1] }));
+
+    CHECK(row_equals(jagged, 0, first));
+    CHECK(jagged.row_count() == 4);
+}
+
+STL_CONTAINER_IMPL_TEST(jagged_vector_empty_without_rows)
+{
+    JaggedVector<std::string> sized;
+    const std::vector<int> noCounts;
+    sized.assign_row_sizes(noCounts.begin(), noCounts.end());
+    CHECK(sized.row_count() == 0);
+    CHECK(sized.empty());
+
+    JaggedVector<std::string> failed;
+    bool thrown = false;
+    try
+    {
+        failed.append_row(ThrowingIterator{ 0, 2 }, ThrowingIterator{ 5, 2 });
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+
+    CHECK(thrown);
+    CHECK(failed.row_count() == 0);
+    CHECK(failed.size() == 0);
+    CHECK(failed.empty());
+
+    failed.append_row({ "row" });
+    CHECK(!failed.empty());
+    CHECK(failed.row_count() == 1);
+}
+
+// Iterator adaptors over pointers take the generic path, so they keep their own semantics.
+STL_CONTAINER_IMPL_TEST(jagged_vector_append_through_iterator_adaptors)
+{
+    std::string strings[] = { std::string(40, 'a'), std::string(40, 'b'), std::string(40, 'c') };
+
+    JaggedVector<std::string> jagged;
+    jagged.append_row(std::rbegin(strings), std::rend(strings));
+    CHECK(row_equals(jagged, 0, { strings[2], strings[1], strings[0] }));
+
+    jagged.append_row(std::make_move_iterator(std::begin(strings)), std::make_move_iterator(std::end(strings)));
+    CHECK(row_equals(jagged, 1, { std::string(40, 'a'), std::string(40, 'b'), std::string(40, 'c') }));
+    CHECK(strings[0].empty() && strings[1].empty() && strings[2].empty());
+
+    std::unique_ptr<int> pointers[] = { std::make_unique<int>(1), std::make_unique<int>(2) };
+    JaggedVector<std::unique_ptr<int>> moveOnly;
+    moveOnly.append_row(std::make_move_iterator(std::begin(pointers)), std::make_move_iterator(std::end(pointers)));
+    CHECK(moveOnly.row(0).size() == 2);
+    CHECK(*moveOnly.row(0)[0] == 1 && *moveOnly.row(0)[1] == 2);
+    CHECK(!pointers[0] && !pointers[1]);
+}
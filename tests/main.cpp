@@ -0,0 +1,29 @@
+#include "test.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : "";
+
+    auto tests = test::registry();
+    std::sort(tests.begin(), tests.end());
+
+    int run = 0;
+    for (const auto& [name, fn] : tests)
+    {
+        if (std::strstr(name.c_str(), filter) == nullptr)
+            continue;
+
+        const auto failuresBefore = test::failure_count();
+        fn();
+        ++run;
+
+        std::printf("%s %s\n", test::failure_count() == failuresBefore ? "[ OK ]" : "[FAIL]", name.c_str());
+    }
+
+    std::printf("%d tests, %d failed checks\n", run, test::failure_count());
+    return test::failure_count() == 0 ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+#include "test.hpp"
+#include "packed_int_vector.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using stl_container_impl::PackedIntVector;
+using stl_container_impl::Vector;
+
+namespace
+{
+    template <std::size_t BlockSize>
+    bool matches(const PackedIntVector<BlockSize>& actual, const std::vector<std::uint64_t>& expected)
+    {
+        if (actual.size() != expected.size())
+            return false;
+
+        for (std::size_t i = 0; i != expected.size(); ++i)
+        {
+            if (actual[i] != expected[i])
+                return false;
+        }
+
+        Vector<std::uint64_t> decoded;
+        actual.decode(decoded);
+        if (decoded.size() != expected.size())
+            return false;
+
+        for (std::size_t i = 0; i != expected.size(); ++i)
+        {
+            if (decoded[i] != expected[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    // One block of blockSize values whose range needs exactly width bits above base.
+    void append_block(std::vector<std::uint64_t>& values, std::size_t blockSize, unsigned width, std::uint64_t base, std::mt19937_64& rng)
+    {
+        const auto mask = width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+        const auto first = values.size();
+        for (std::size_t i = 0; i != blockSize; ++i)
+            values.push_back(base + (rng() & mask));
+
+        // Pin the minimum and, for non-zero widths, the top bit of the range at random positions
+        values[first + rng() % blockSize] = base;
+        if (width != 0)
+            values[first + rng() % blockSize] = base + mask;
+    }
+
+    template <std::size_t BlockSize>
+    void check_all_widths(std::mt19937_64& rng)
+    {
+        std::vector<std::uint64_t> expected;
+        for (unsigned width = 0; width <= 64; ++width)
+        {
+            const auto base = width == 64 ? 0 : std::numeric_limits<std::uint64_t>::max() - ((std::uint64_t(1) << width) - 1) - rng() % 1000;
+            append_block(expected, BlockSize, width, base, rng);
+        }
+
+        // Mixed widths next to each other, then a partial tail
+        for (const unsigned width : { 3u, 64u, 0u, 17u, 1u, 63u })
+            append_block(expected, BlockSize, width, rng() % 1000, rng);
+        for (std::size_t i = 0; i != BlockSize / 2 + 3; ++i)
+            expected.push_back(rng());
+
+        PackedIntVector<BlockSize> actual;
+        for (std::size_t i = 0; i != expected.size(); ++i)
+        {
+            actual.push_back(expected[i]);
+
+            // The unsealed tail and the block sealed just now
+            CHECK(actual[i] == expected[i]);
+            if ((i + 1) % BlockSize == 0)
+                CHECK(actual[i + 1 - BlockSize] == expected[i + 1 - BlockSize]);
+        }
+
+        CHECK(matches(actual, expected));
+
+        actual.shrink_to_fit();
+        CHECK(matches(actual, expected));
+    }
+
+} // namespace
+
+// Every bit width (0 to 64), values straddling word boundaries, and the unsealed tail, against
+// std::vector through operator[] and decode().
+STL_CONTAINER_IMPL_TEST(packed_int_vector_matches_reference_model)
+{
+    std::mt19937_64 rng(5);
+    check_all_widths<256>(rng);
+    check_all_widths<512>(rng);
+}
+
+STL_CONTAINER_IMPL_TEST(packed_int_vector_edge_cases)
+{
+    PackedIntVector<> packed;
+    CHECK(packed.empty());
+    CHECK(matches(packed, {}));
+
+    // Only a partial tail
+    std::vector<std::uint64_t> expected{ 5, 0, std::numeric_limits<std::uint64_t>::max() };
+    for (const auto value : expected)
+        packed.push_back(value);
+    CHECK(matches(packed, expected));
+
+    bool threw = false;
+    try
+    {
+        packed.at(expected.size());
+    }
+    catch (const std::out_of_range&)
+    {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(packed.at(2) == std::numeric_limits<std::uint64_t>::max());
+
+    // Exactly one sealed block and an empty tail
+    packed.clear();
+    expected.clear();
+    CHECK(packed.size() == 0);
+    for (std::uint64_t i = 0; i != 256; ++i)
+    {
+        expected.push_back(i * i);
+        packed.push_back(i * i);
+    }
+    CHECK(matches(packed, expected));
+}
@@ -0,0 +1,231 @@
+#include "test.hpp"
+#include "priority_queue.hpp"
+
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using stl_container_impl::PriorityQueue;
+
+namespace
+{
+    // Copying throws once copies_left reaches zero; moving never throws.
+    struct ThrowingCopy
+    {
+        static int copies_left;
+
+        int value;
+
+        explicit ThrowingCopy(int value) noexcept
+            : value(value)
+        {
+        }
+
+        ThrowingCopy(const ThrowingCopy& other)
+            : value(other.value)
+        {
+            if (copies_left-- == 0)
+                throw std::runtime_error("ThrowingCopy");
+        }
+
+        ThrowingCopy(ThrowingCopy&&) noexcept = default;
+        ThrowingCopy& operator=(const ThrowingCopy&) = default;
+        ThrowingCopy& operator=(ThrowingCopy&&) noexcept = default;
+
+        friend bool operator<(const ThrowingCopy& lhs, const ThrowingCopy& rhs) noexcept
+        {
+            return lhs.value < rhs.value;
+        }
+    };
+
+    int ThrowingCopy::copies_left = std::numeric_limits<int>::max();
+
+    // Pops everything, checking the values come out in non-increasing order.
+    template <typename Queue>
+    bool drains_in_order(Queue& queue)
+    {
+        bool ordered = true;
+        int previous = std::numeric_limits<int>::max();
+        for (; !queue.empty(); queue.pop())
+        {
+            ordered = ordered && queue.top().value <= previous;
+            previous = queue.top().value;
+        }
+        return ordered;
+    }
+
+} // namespace
+
+STL_CONTAINER_IMPL_TEST(priority_queue_matches_std_priority_queue)
+{
+    std::mt19937 rng(3);
+    PriorityQueue<int, std::greater<int>, 4> actual;
+    std::priority_queue<int, std::vector<int>, std::greater<int>> expected;
+
+    for (int step = 0; step != 50000; ++step)
+    {
+        const auto op = rng() % 8;
+        if (op < 4 || expected.empty())
+        {
+            const int value = static_cast<int>(rng() % 1000);
+            actual.push(value);
+            expected.push(value);
+        }
+        else if (op < 7)
+        {
+            CHECK(actual.top() == expected.top());
+            actual.pop();
+            expected.pop();
+        }
+        else
+        {
+            const int value = static_cast<int>(rng() % 1000);
+            actual.pop_push(value);
+            expected.pop();
+            expected.push(value);
+        }
+
+        CHECK(actual.size() == expected.size());
+        if (!expected.empty())
+            CHECK(actual.top() == expected.top());
+    }
+
+    std::vector<int> batch;
+    for (int i = 0; i != 5000; ++i)
+        batch.push_back(static_cast<int>(rng() % 1000));
+
+    actual.push_range(batch.begin(), batch.end());
+    for (const auto value : batch)
+        expected.push(value);
+
+    while (!expected.empty())
+    {
+        CHECK(actual.top() == expected.top());
+        actual.pop();
+        expected.pop();
+    }
+    CHECK(actual.empty());
+}
+
+// Handles against a multiset of (value, handle) pairs.
+STL_CONTAINER_IMPL_TEST(priority_queue_handles_match_reference_model)
+{
+    std::mt19937 rng(4);
+    PriorityQueue<int, std::less<int>, 3, true> actual;
+    std::multiset<int> expected;
+    std::map<std::size_t, int> live; // handle -> value
+
+    for (int step = 0; step != 20000; ++step)
+    {
+        const auto op = rng() % 6;
+        if (op < 2 || live.empty())
+        {
+            const int value = static_cast<int>(rng() % 10000);
+            const auto handle = actual.push(value);
+            CHECK(live.count(handle) == 0);
+            live[handle] = value;
+            expected.insert(value);
+        }
+        else if (op < 4)
+        {
+            auto it = live.begin();
+            std::advance(it, rng() % live.size());
+
+            const int value = static_cast<int>(rng() % 10000);
+            CHECK(actual.contains(it->first));
+            CHECK(actual.value(it->first) == it->second);
+            actual.update(it->first, value);
+            expected.erase(expected.find(it->second));
+            expected.insert(value);
+            it->second = value;
+        }
+        else if (op == 4)
+        {
+            auto it = live.begin();
+            std::advance(it, rng() % live.size());
+
+            const int value = it->second + 1 + static_cast<int>(rng() % 100);
+            actual.decrease_key(it->first, value); // moves towards the top for std::less
+            expected.erase(expected.find(it->second));
+            expected.insert(value);
+            it->second = value;
+        }
+        else
+        {
+            CHECK(actual.top() == *expected.rbegin());
+            actual.pop();
+            expected.erase(std::prev(expected.end()));
+
+            // The popped element's handle is the one that is no longer contained
+            for (auto it = live.begin(); it != live.end(); ++it)
+            {
+                if (!actual.contains(it->first))
+                {
+                    live.erase(it);
+                    break;
+                }
+            }
+        }
+
+        CHECK(actual.size() == expected.size());
+        CHECK(actual.size() == live.size());
+        if (!expected.empty())
+            CHECK(actual.top() == *expected.rbegin());
+    }
+}
+
+// A throwing copy in the middle of a batch keeps the elements appended so far, in heap order.
+STL_CONTAINER_IMPL_TEST(priority_queue_push_range_restores_heap_on_exception)
+{
+    const std::vector<ThrowingCopy> batch{ ThrowingCopy(100), ThrowingCopy(200), ThrowingCopy(300) };
+
+    // Small batch: sifted up one by one
+    PriorityQueue<ThrowingCopy> queue;
+    for (int i = 0; i != 10; ++i)
+        queue.push(ThrowingCopy(i));
+
+    ThrowingCopy::copies_left = 2;
+    bool threw = false;
+    try
+    {
+        queue.push_range(batch.begin(), batch.end());
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(queue.size() == 12);
+    CHECK(queue.top().value == 200);
+    CHECK(drains_in_order(queue));
+
+    // Batch larger than the heap: heapified, with handles
+    PriorityQueue<ThrowingCopy, std::less<ThrowingCopy>, 4, true> tracked;
+    tracked.push(ThrowingCopy(1));
+
+    ThrowingCopy::copies_left = 2;
+    threw = false;
+    try
+    {
+        tracked.push_range(batch.begin(), batch.end());
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(tracked.size() == 3);
+    CHECK(tracked.top().value == 200);
+    CHECK(drains_in_order(tracked));
+
+    // Handles freed by the failed construction are reused
+    ThrowingCopy::copies_left = std::numeric_limits<int>::max();
+    const auto handle = tracked.push(ThrowingCopy(5));
+    CHECK(tracked.contains(handle));
+    CHECK(tracked.value(handle).value == 5);
+}
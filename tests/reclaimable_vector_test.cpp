@@ -0,0 +1,41 @@
+#include "test.hpp"
+#include "reclaimable_vector.hpp"
+
+using stl_container_impl::ReclaimableVector;
+using stl_container_impl::ReclamationRegistry;
+
+namespace
+{
+    // Number of trim() passes that reclaim nothing before one does.
+    int passes_until_trimmed(ReclamationRegistry& registry)
+    {
+        int passes = 0;
+        while (registry.trim() == 0 && passes != 1000)
+            ++passes;
+        return passes;
+    }
+
+} // namespace
+
+STL_CONTAINER_IMPL_TEST(reclaimable_vector_backoff_doubles_and_decays)
+{
+    ReclamationRegistry registry;
+    ReclaimableVector<int> vector(registry);
+    vector.lock()->resize(10);
+    vector.lock()->reserve(4096);
+
+    CHECK(passes_until_trimmed(registry) == 0);
+
+    // Growing back right after every trim doubles the number of passes it is left alone
+    for (const int expected : { 2, 4, 8 })
+    {
+        vector.lock()->reserve(4096);
+        CHECK(passes_until_trimmed(registry) == expected + 1);
+    }
+
+    // A pass within the trimmed capacity resets the backoff, so the next growth costs 2 passes again
+    CHECK(registry.trim() == 0);
+    vector.lock()->reserve(4096);
+    CHECK(passes_until_trimmed(registry) == 3);
+    CHECK(vector.lock()->size() == 10);
+}
@@ -0,0 +1,104 @@
+#include "test.hpp"
+#include "ring_buffer.hpp"
+
+#include <deque>
+#include <random>
+#include <string>
+
+using stl_container_impl::RingBuffer;
+
+namespace
+{
+    bool equals(const RingBuffer<int>& actual, const std::deque<int>& expected)
+    {
+        if (actual.size() != expected.size())
+            return false;
+
+        for (std::size_t i = 0; i != expected.size(); ++i)
+        {
+            if (actual[i] != expected[i])
+                return false;
+        }
+
+        return std::equal(actual.begin(), actual.end(), expected.begin());
+    }
+
+} // namespace
+
+STL_CONTAINER_IMPL_TEST(ring_buffer_matches_reference_model)
+{
+    std::mt19937 rng(2);
+    RingBuffer<int> actual;
+    std::deque<int> expected;
+
+    for (int step = 0; step != 50000; ++step)
+    {
+        const auto op = rng() % 10;
+        if (op < 3)
+        {
+            actual.push_back(step);
+            expected.push_back(step);
+        }
+        else if (op < 5)
+        {
+            actual.push_front(step);
+            expected.push_front(step);
+        }
+        else if (op < 7 && !expected.empty())
+        {
+            actual.pop_front();
+            expected.pop_front();
+        }
+        else if (op < 9 && !expected.empty())
+        {
+            actual.pop_back();
+            expected.pop_back();
+        }
+        else if (!expected.empty())
+        {
+            const auto count = rng() % (expected.size() + 1);
+            actual.pop_front(count);
+            expected.erase(expected.begin(), expected.begin() + count);
+        }
+
+        if (step % 1000 == 0)
+            CHECK(equals(actual, expected));
+    }
+
+    CHECK(equals(actual, expected));
+
+    const auto [first, second] = actual.segments();
+    CHECK(first.size() + second.size() == expected.size());
+}
+
+// Pushing an element of the buffer itself while it is full must read it before it is relocated.
+STL_CONTAINER_IMPL_TEST(ring_buffer_push_of_own_element_when_full)
+{
+    RingBuffer<int> ints;
+    for (int i = 0; i != 4; ++i)
+        ints.push_back(i);
+
+    CHECK(ints.size() == ints.capacity());
+    ints.push_back(ints.front());
+    CHECK(ints.back() == 0);
+
+    for (int i = 5; ints.size() != ints.capacity(); ++i)
+        ints.push_back(i);
+    ints.push_front(ints.back());
+    CHECK(ints.front() == ints.back());
+    CHECK(ints[1] == 0);
+
+    RingBuffer<std::string> strings;
+    strings.push_back(std::string(40, 'a'));
+    strings.push_front(std::string(40, 'b')); // wraps: front lives at the end of the buffer
+    CHECK(strings.size() == strings.capacity());
+
+    strings.push_back(strings.front());
+    CHECK(strings.back() == std::string(40, 'b'));
+
+    while (strings.size() != strings.capacity())
+        strings.push_back("x");
+    strings.emplace_front(strings[1]);
+    CHECK(strings.front() == std::string(40, 'a'));
+    CHECK(strings[1] == std::string(40, 'b'));
+}
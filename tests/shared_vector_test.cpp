@@ -0,0 +1,89 @@
+#include "test.hpp"
+#include "shared_vector.hpp"
+
+#include <atomic>
+#include <thread>
+
+using stl_container_impl::AtomicSharedVector;
+using stl_container_impl::SharedVector;
+
+STL_CONTAINER_IMPL_TEST(shared_vector_copy_on_write)
+{
+    SharedVector<int> original{ 1, 2, 3 };
+    SharedVector<int> copy = original;
+    CHECK(copy.shares_storage_with(original));
+
+    copy.set(0, 10);
+    CHECK(!copy.shares_storage_with(original));
+    CHECK(original[0] == 1);
+    CHECK(copy[0] == 10);
+
+    copy.mutate().reserve(8);
+    const auto data = copy.data();
+    copy.push_back(4); // unique and with spare capacity: modified in place
+    CHECK(copy.size() == 4);
+    CHECK(copy.data() == data);
+
+    // Shared again: the next write copies
+    const SharedVector<int> snapshot = copy;
+    copy.push_back(5);
+    CHECK(copy.data() != data);
+    CHECK(snapshot.data() == data);
+    CHECK(snapshot.size() == 4);
+
+    SharedVector<int> empty;
+    empty.clear();
+    CHECK(empty.empty());
+
+    SharedVector<int> shared = original;
+    shared.clear();
+    CHECK(shared.empty());
+    CHECK(original.size() == 3);
+
+    original = std::move(copy);
+    CHECK(original.size() == 5);
+    CHECK(copy.empty());
+}
+
+/*---------------------------------------------------------------------------------------------
+ * A reader takes snapshots and drops them while the writer keeps mutating its own copy.
+ * Once the writer's copy is unique again it is modified in place; the reader must have
+ * finished with the shared storage by then, which the acquire/release reference count
+ * guarantees. Run under ThreadSanitizer to check the ordering, the values are checked always.
+ -----------------------------------------------------------------------------------------------*/
+STL_CONTAINER_IMPL_TEST(shared_vector_snapshot_released_before_in_place_write)
+{
+    AtomicSharedVector<int> published;
+    std::atomic<bool> done{ false };
+    std::atomic<int> badSnapshots{ 0 };
+
+    std::thread reader([&] {
+        AtomicSharedVector<int>::Reader handle(published);
+        while (!done.load(std::memory_order_relaxed))
+        {
+            const auto snapshot = handle.acquire();
+            for (std::size_t i = 1; i < snapshot.size(); ++i)
+            {
+                if (snapshot[i] != snapshot[0])
+                    badSnapshots.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    SharedVector<int> writer{ 0, 0, 0, 0, 0, 0, 0, 0 };
+    for (int version = 1; version != 20000; ++version)
+    {
+        // Shared with the published node and possibly a reader snapshot: copies. Otherwise
+        // (the node was reclaimed and the snapshot dropped) it writes in place.
+        for (std::size_t i = 0; i != writer.size(); ++i)
+            writer.set(i, version);
+
+        published.publish(writer);
+        published.publish(SharedVector<int>{}); // retires the node sharing writer's storage
+    }
+
+    done.store(true, std::memory_order_relaxed);
+    reader.join();
+
+    CHECK(badSnapshots.load() == 0);
+}
@@ -0,0 +1,224 @@
+#include "test.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+using stl_container_impl::String;
+using stl_container_impl::Vector;
+
+namespace
+{
+    template <typename Lhs, typename Rhs, typename = void>
+    struct is_equality_comparable : std::false_type
+    {
+    };
+
+    template <typename Lhs, typename Rhs>
+    struct is_equality_comparable<Lhs, Rhs, std::void_t<decltype(std::declval<Lhs>() == std::declval<Rhs>()), decltype(std::declval<Lhs>() != std::declval<Rhs>())>>
+        : std::true_type
+    {
+    };
+
+    // Ambiguous overloads make the expression ill-formed, which these detect at compile time.
+    static_assert(is_equality_comparable<const String&, const char (&)[4]>::value, "String == literal");
+    static_assert(is_equality_comparable<const char (&)[4], const String&>::value, "literal == String");
+    static_assert(is_equality_comparable<const String&, const char*>::value, "String == const char*");
+    static_assert(is_equality_comparable<const String&, std::string_view>::value, "String == string_view");
+    static_assert(is_equality_comparable<std::string_view, const String&>::value, "string_view == String");
+    static_assert(is_equality_comparable<const String&, const std::string&>::value, "String == std::string");
+    static_assert(is_equality_comparable<const String&, const String&>::value, "String == String");
+
+} // namespace
+
+STL_CONTAINER_IMPL_TEST(string_compares_with_literals_and_views)
+{
+    String empty;
+    CHECK(empty == "");
+    CHECK(empty != "abc");
+    CHECK("" == empty);
+
+    String inlined = "abc";
+    CHECK(inlined == "abc");
+    CHECK("abc" == inlined);
+    CHECK(inlined != "abd");
+    CHECK("ab" != inlined);
+    CHECK(inlined == std::string_view("abc"));
+    CHECK(std::string_view("abcd") != inlined);
+    CHECK(inlined == std::string("abc"));
+
+    // Long enough to live on the heap
+    const std::string text(100, 'x');
+    String heap = text.c_str();
+    CHECK(heap == text.c_str());
+    CHECK(text.c_str() == heap);
+    CHECK(heap != inlined);
+    CHECK(heap == String(text.c_str()));
+}
+
+// 23 characters fit inline in the 32-byte object, the 24th moves the string to the heap.
+STL_CONTAINER_IMPL_TEST(string_inline_capacity_boundary)
+{
+    static_assert(sizeof(String) == 32, "String is 32 bytes");
+    static_assert(String::inline_capacity == 23, "23 inline characters");
+
+    String s;
+    CHECK(s.capacity() == 23);
+    const auto local = s.data();
+    CHECK(reinterpret_cast<const char*>(&s) <= local && local < reinterpret_cast<const char*>(&s) + sizeof(String));
+
+    const std::string expected = "abcdefghijklmnopqrstuvwxyz";
+    for (std::size_t i = 0; i != 23; ++i)
+        s.push_back(expected[i]);
+    CHECK(s.data() == local);
+    CHECK(s.capacity() == 23);
+    CHECK(s == std::string_view(expected).substr(0, 23));
+    CHECK(std::strlen(s.c_str()) == 23);
+
+    s.push_back(expected[23]);
+    CHECK(s.data() != local);
+    CHECK(s.capacity() >= 24);
+    CHECK(s == std::string_view(expected).substr(0, 24));
+    CHECK(s.c_str()[24] == '\0');
+
+    // Copies and moves on both sides of the boundary
+    const String inlined(expected.substr(0, 23).c_str());
+    const String heap(expected.substr(0, 24).c_str());
+    CHECK(inlined.capacity() == 23);
+    CHECK(heap.capacity() >= 24);
+
+    String copy = heap;
+    CHECK(copy == heap && copy.data() != heap.data());
+    String moved = std::move(copy);
+    CHECK(moved == heap);
+    CHECK(copy.empty() && copy.capacity() == 23);
+
+    moved = inlined;
+    CHECK(moved == inlined && moved.capacity() >= 24);
+
+    // Growing an inline string past the boundary moves it to the heap
+    String grown = inlined;
+    grown.append(std::string(17, 'z').c_str(), 17);
+    CHECK(grown.size() == 40 && grown[39] == 'z' && grown[22] == inlined[22]);
+    CHECK(grown.c_str()[40] == '\0');
+}
+
+// Views into the string itself, with and without a reallocation.
+STL_CONTAINER_IMPL_TEST(string_append_and_assign_from_own_view)
+{
+    String s = "0123456789";
+    s.append(s.view());
+    CHECK(s == "01234567890123456789");
+
+    s.append(std::string_view(s).substr(2, 3)); // fits inline: 23 characters
+    CHECK(s == "01234567890123456789234");
+    CHECK(s.capacity() == 23);
+
+    s.append(s.view()); // needs the heap
+    CHECK(s == "0123456789012345678923401234567890123456789234");
+
+    s.append(std::string_view(s).substr(40)); // heap, possibly in place
+    CHECK(s == "0123456789012345678923401234567890123456789234789234");
+
+    s.assign(std::string_view(s).substr(10, 5));
+    CHECK(s == "01234");
+
+    // Heap string assigned from an overlapping part of itself, and from all of itself
+    std::string reference;
+    for (int i = 0; i != 60; ++i)
+        reference += char('a' + i % 26);
+    String t(reference.c_str());
+    t.assign(std::string_view(t).substr(5, 30));
+    CHECK(t == std::string_view(reference).substr(5, 30));
+    t.assign(t.view());
+    CHECK(t == std::string_view(reference).substr(5, 30));
+    t = std::string_view(t).substr(1);
+    CHECK(t == std::string_view(reference).substr(6, 29));
+}
+
+STL_CONTAINER_IMPL_TEST(string_resize_and_overwrite_shorter)
+{
+    String s = "prefix";
+    s.resize_and_overwrite(100, [](char* buffer, std::size_t count) {
+        CHECK(count == 100);
+        CHECK(std::string_view(buffer, 6) == "prefix");
+        std::memcpy(buffer + 6, "-tail", 5);
+        return std::size_t(11);
+    });
+    CHECK(s == "prefix-tail");
+    CHECK(s.size() == 11);
+    CHECK(s.capacity() >= 100);
+    CHECK(s.c_str()[11] == '\0');
+
+    // Within the inline buffer, down to empty
+    String small = "abc";
+    small.resize_and_overwrite(10, [](char*, std::size_t) { return std::size_t(0); });
+    CHECK(small.empty());
+    CHECK(small.c_str()[0] == '\0');
+    CHECK(small.capacity() == 23);
+}
+
+STL_CONTAINER_IMPL_TEST(string_find_edge_cases)
+{
+    const String s = "abcabcabd";
+    const std::string reference = "abcabcabd";
+
+    // Empty needle: found at pos while pos <= size()
+    CHECK(s.find("") == 0);
+    CHECK(s.find("", 4) == 4);
+    CHECK(s.find("", 9) == 9);
+    CHECK(s.find("", 10) == String::npos);
+
+    // Missing needles, including one longer than the string
+    CHECK(s.find("abe") == String::npos);
+    CHECK(s.find("abcabcabda") == String::npos);
+    CHECK(s.find('z') == String::npos);
+    CHECK(String().find('a') == String::npos);
+    CHECK(String().find("a") == String::npos);
+
+    // Match at the very start and end, repeated first characters, and every start position
+    CHECK(s.find("abc") == 0);
+    CHECK(s.find("abd") == 6);
+    CHECK(s.find('d') == 8);
+    CHECK(s.find('d', 9) == String::npos);
+    for (std::size_t pos = 0; pos <= reference.size() + 1; ++pos)
+    {
+        for (const char* needle : { "a", "ab", "abc", "cab", "bd", "abcabcabd", "d" })
+        {
+            const auto expected = reference.find(needle, pos);
+            CHECK(s.find(needle, pos) == (expected == std::string::npos ? String::npos : expected));
+        }
+        const auto expected = reference.find('c', pos);
+        CHECK(s.find('c', pos) == (expected == std::string::npos ? String::npos : expected));
+    }
+}
+
+// Vector<String> relocates its elements with memcpy: heap buffers are carried over as they are.
+STL_CONTAINER_IMPL_TEST(string_vector_growth_relocates)
+{
+    static_assert(stl_container_impl::is_trivially_relocatable_v<String>, "String is trivially relocatable");
+
+    Vector<String> strings;
+    Vector<const char*> heapData;
+    for (int i = 0; i != 1000; ++i)
+    {
+        const auto text = std::to_string(i) + std::string(i % 40, 'x');
+        strings.push_back(String(text.c_str()));
+        heapData.push_back(text.size() > String::inline_capacity ? strings[i].data() : nullptr);
+    }
+
+    for (int i = 0; i != 1000; ++i)
+    {
+        const auto text = std::to_string(i) + std::string(i % 40, 'x');
+        CHECK(strings[i] == text);
+        if (heapData[i] != nullptr)
+            CHECK(strings[i].data() == heapData[i]);
+    }
+
+    strings.shrink_to_fit();
+    CHECK(strings[999] == std::to_string(999) + std::string(999 % 40, 'x'));
+}
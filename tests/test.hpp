@@ -0,0 +1,57 @@
+#pragma once
+
+// Minimal test harness: each tests/*.cpp registers cases with STL_CONTAINER_IMPL_TEST and checks
+// conditions with CHECK, tests/main.cpp runs them and fails if any check failed.
+// CHECK does not depend on NDEBUG, so the tests also check in Release builds.
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace test
+{
+    using TestFn = void (*)();
+
+    inline std::vector<std::pair<std::string, TestFn>>& registry()
+    {
+        static std::vector<std::pair<std::string, TestFn>> tests;
+        return tests;
+    }
+
+    inline int& failure_count()
+    {
+        static int failures = 0;
+        return failures;
+    }
+
+    struct Registrar
+    {
+        Registrar(const char* name, TestFn fn)
+        {
+            registry().emplace_back(name, fn);
+        }
+    };
+
+    inline void fail(const char* expression, const char* file, int line)
+    {
+        ++failure_count();
+        std::printf("%s:%d: CHECK(%s) failed\n", file, line, expression);
+    }
+
+} // namespace test
+
+#define CHECK(expression)                                     \
+    do                                                        \
+    {                                                         \
+        if (!(expression))                                    \
+            test::fail(#expression, __FILE__, __LINE__);      \
+    } while (false)
+
+#define STL_CONTAINER_IMPL_TEST_CONCAT_(a, b) a##b
+#define STL_CONTAINER_IMPL_TEST_CONCAT(a, b) STL_CONTAINER_IMPL_TEST_CONCAT_(a, b)
+
+#define STL_CONTAINER_IMPL_TEST(name)                                                               \
+    static void name();                                                                            \
+    static const test::Registrar STL_CONTAINER_IMPL_TEST_CONCAT(name, _registrar)(#name, &name); \
+    static void name()
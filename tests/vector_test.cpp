@@ -0,0 +1,171 @@
+#include "test.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+using stl_container_impl::Vector;
+
+namespace
+{
+    // Counts live instances; construction from an int throws once throw_countdown reaches zero.
+    struct Counted
+    {
+        static int live;
+        static int throw_countdown;
+
+        int value;
+
+        explicit Counted(int value)
+            : value(value)
+        {
+            if (throw_countdown-- == 0)
+                throw std::runtime_error("Counted");
+            ++live;
+        }
+
+        Counted(const Counted& other)
+            : value(other.value)
+        {
+            ++live;
+        }
+
+        ~Counted()
+        {
+            --live;
+        }
+    };
+
+    int Counted::live = 0;
+    int Counted::throw_countdown = -1;
+
+    // std::allocator that tracks the number of elements currently allocated.
+    template <class T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+
+        CountingAllocator() = default;
+
+        template <class U>
+        CountingAllocator(const CountingAllocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t count)
+        {
+            outstanding += count;
+            return std::allocator<T>().allocate(count);
+        }
+
+        void deallocate(T* ptr, std::size_t count) noexcept
+        {
+            outstanding -= count;
+            std::allocator<T>().deallocate(ptr, count);
+        }
+
+        friend bool operator==(const CountingAllocator&, const CountingAllocator&) noexcept
+        {
+            return true;
+        }
+
+        friend bool operator!=(const CountingAllocator&, const CountingAllocator&) noexcept
+        {
+            return false;
+        }
+
+        static std::size_t outstanding;
+    };
+
+    template <class T>
+    std::size_t CountingAllocator<T>::outstanding = 0;
+
+} // namespace
+
+// A constructor throwing from the k-th emplace destroys the elements appended before it and
+// leaves the vector's size unchanged.
+STL_CONTAINER_IMPL_TEST(vector_back_appender_rolls_back_on_exception)
+{
+    {
+        Vector<Counted> vector;
+        for (int i = 0; i != 3; ++i)
+            vector.push_back(Counted(i));
+        CHECK(Counted::live == 3);
+
+        Counted::throw_countdown = 4;
+        bool threw = false;
+        try
+        {
+            auto appender = vector.reserve_append(8);
+            for (int i = 0; i != 8; ++i)
+                appender.emplace(100 + i);
+        }
+        catch (const std::runtime_error&)
+        {
+            threw = true;
+        }
+        Counted::throw_countdown = -1;
+
+        CHECK(threw);
+        CHECK(vector.size() == 3);
+        CHECK(Counted::live == 3);
+        CHECK(vector[0].value == 0 && vector[2].value == 2);
+
+        // The capacity stays reserved and a later append commits normally
+        {
+            auto appender = vector.reserve_append(2);
+            appender.emplace(7);
+            appender.emplace(8);
+            CHECK(appender.size() == 2);
+        }
+        CHECK(vector.size() == 5);
+        CHECK(vector[4].value == 8);
+        CHECK(Counted::live == 5);
+    }
+
+    CHECK(Counted::live == 0);
+}
+
+// Shrinking relocates into a smaller buffer: the old elements are destroyed and the old buffer
+// freed, and an empty vector gives its buffer back entirely.
+STL_CONTAINER_IMPL_TEST(vector_shrink_destroys_old_elements_and_frees_buffer)
+{
+    using Allocator = CountingAllocator<Counted>;
+    {
+        Vector<Counted, Allocator> vector;
+        vector.reserve(100);
+        for (int i = 0; i != 10; ++i)
+            vector.push_back(Counted(i));
+        CHECK(Counted::live == 10);
+        CHECK(Allocator::outstanding == 100);
+
+        vector.shrink_to(20);
+        CHECK(vector.capacity() == 20);
+        CHECK(Counted::live == 10);
+        CHECK(Allocator::outstanding == 20);
+
+        vector.shrink_to_fit();
+        CHECK(vector.capacity() == 10);
+        CHECK(Counted::live == 10);
+        CHECK(Allocator::outstanding == 10);
+        CHECK(vector[0].value == 0 && vector[9].value == 9);
+
+        // Below size(): shrinks to size() only, here a no-op
+        vector.shrink_to(3);
+        CHECK(vector.capacity() == 10);
+
+        vector.clear();
+        CHECK(Counted::live == 0);
+        vector.shrink_to_fit();
+        CHECK(vector.capacity() == 0);
+        CHECK(vector.data() == nullptr);
+        CHECK(Allocator::outstanding == 0);
+
+        vector.push_back(Counted(1));
+        CHECK(vector.size() == 1);
+    }
+
+    CHECK(Counted::live == 0);
+    CHECK(Allocator::outstanding == 0);
+}